@@ -0,0 +1,184 @@
+/* Name: Talha Akhlaq
+Description: This file implements batch spell checking, which checks many documents against one loaded
+dictionary. Jobs come from a manifest or a directory tree and are spread over a fixed pool of workers.
+*/
+
+#include "batch.h"
+#include "checker.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <filesystem>
+
+using namespace std;
+namespace fs = std::filesystem;
+
+namespace
+{
+  // Check one document; returns false if either file could not be opened or the report could not be written
+  bool checkJob(const batchJob &job, const hashTable &dictionary, string &error)
+  {
+    ifstream inputStream(job.input);
+    if (!inputStream.is_open())
+    {
+      error = "Could not open input file: " + job.input;
+      return false;
+    }
+
+    error_code ec;
+    fs::path parent = fs::path(job.output).parent_path();
+    if (!parent.empty())
+    {
+      fs::create_directories(parent, ec);
+    }
+
+    ofstream outputStream(job.output);
+    if (!outputStream.is_open())
+    {
+      error = "Could not open output file: " + job.output;
+      return false;
+    }
+
+    checkDocument(inputStream, outputStream, dictionary);
+
+    // A full disk or I/O error only shows up on the stream once the buffer is written out
+    outputStream.flush();
+    outputStream.close();
+    if (outputStream.fail())
+    {
+      error = "Could not write output file: " + job.output;
+      return false;
+    }
+    return true;
+  }
+
+  // Claim jobs one at a time until none are left
+  void batchWorker(const vector<batchJob> &jobs, const hashTable &dictionary, atomic<size_t> &next,
+                   atomic<int> &failures, mutex &errorLock)
+  {
+    string error;
+    for (size_t i = next++; i < jobs.size(); i = next++)
+    {
+      if (!checkJob(jobs[i], dictionary, error))
+      {
+        failures++;
+        lock_guard<mutex> lock(errorLock);
+        cerr << "Error: " << error << endl;
+      }
+    }
+  }
+}
+
+// Walk the directory tree and mirror it under the output directory
+bool jobsFromDirectory(const string &inputDir, const string &outputDir, vector<batchJob> &jobs)
+{
+  error_code ec;
+  fs::recursive_directory_iterator it(inputDir, ec);
+  if (ec)
+  {
+    cerr << "Error: Could not read directory: " << inputDir << endl;
+    return false;
+  }
+
+  for (; it != fs::recursive_directory_iterator(); it.increment(ec))
+  {
+    if (ec)
+    {
+      cerr << "Error: Could not read directory: " << inputDir << endl;
+      return false;
+    }
+    if (!it->is_regular_file())
+    {
+      continue;
+    }
+
+    fs::path relative = fs::relative(it->path(), inputDir);
+    fs::path report = fs::path(outputDir) / relative;
+    report += ".out";
+    jobs.push_back({it->path().string(), report.string()});
+  }
+  return true;
+}
+
+// Read input paths (and optional report paths) from the manifest
+bool jobsFromManifest(const string &manifestFile, const string &outputDir, vector<batchJob> &jobs)
+{
+  ifstream manifest(manifestFile);
+  if (!manifest.is_open())
+  {
+    cerr << "Error: Could not open manifest: " << manifestFile << endl;
+    return false;
+  }
+
+  set<string> reports;
+  string line;
+  while (getline(manifest, line))
+  {
+    if (!line.empty() && line.back() == '\r')
+    {
+      line.pop_back();
+    }
+    if (line.empty())
+    {
+      continue;
+    }
+
+    batchJob job;
+    size_t tab = line.find('\t');
+    if (tab != string::npos)
+    {
+      job.input = line.substr(0, tab);
+      job.output = line.substr(tab + 1);
+    }
+    else
+    {
+      job.input = line;
+      job.output = (fs::path(outputDir) / (fs::path(line).filename().string() + ".out")).string();
+    }
+
+    // Two inputs with the same file name would silently overwrite each other's report
+    if (!reports.insert(job.output).second)
+    {
+      cerr << "Error: More than one input maps to report " << job.output
+           << "; name the reports explicitly in the manifest" << endl;
+      return false;
+    }
+    jobs.push_back(job);
+  }
+  return true;
+}
+
+// Spread the jobs over the workers and wait for all of them
+int runBatch(const vector<batchJob> &jobs, const hashTable &dictionary, int workers)
+{
+  if (workers < 1)
+  {
+    workers = 1;
+  }
+  if (static_cast<size_t>(workers) > jobs.size())
+  {
+    workers = jobs.empty() ? 1 : static_cast<int>(jobs.size());
+  }
+
+  atomic<size_t> next(0);
+  atomic<int> failures(0);
+  mutex errorLock;
+
+  vector<thread> pool;
+  for (int i = 0; i < workers; ++i)
+  {
+    pool.emplace_back(batchWorker, cref(jobs), cref(dictionary), ref(next), ref(failures), ref(errorLock));
+  }
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+
+  return failures;
+}
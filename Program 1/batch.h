@@ -0,0 +1,32 @@
+#ifndef _BATCH_H
+#define _BATCH_H
+
+#include <string>
+#include <vector>
+#include "hash.h"
+
+// One document to check and the report file to write for it
+struct batchJob
+{
+  std::string input;
+  std::string output;
+};
+
+// Build one job per regular file under inputDir (recursively).
+// Reports mirror the directory layout under outputDir with ".out" appended.
+// Returns false if inputDir cannot be read.
+bool jobsFromDirectory(const std::string &inputDir, const std::string &outputDir, std::vector<batchJob> &jobs);
+
+// Build jobs from a manifest with one input path per line.
+// A line may name its report explicitly as "input<TAB>output";
+// otherwise the report is outputDir/<file name>.out.
+// Returns false if the manifest cannot be read or two inputs map to the same report.
+bool jobsFromManifest(const std::string &manifestFile, const std::string &outputDir, std::vector<batchJob> &jobs);
+
+// Check every job against the dictionary using the given number of workers.
+// Each worker has at most one input and one report open at a time,
+// so the number of open files never exceeds twice the worker count.
+// Returns the number of jobs that failed.
+int runBatch(const std::vector<batchJob> &jobs, const hashTable &dictionary, int workers);
+
+#endif //_BATCH_H
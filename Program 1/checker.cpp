@@ -0,0 +1,403 @@
+/* Name: Talha Akhlaq
+Description: This file loads the dictionary into a hash table and checks documents against it.
+It is shared by the interactive spell-checker and the daemon so both produce identical reports.
+*/
+
+#include "checker.h"
+#include "utf8.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <iterator>
+#include <charconv>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+using namespace std;
+
+namespace
+{
+  // Ends the current word: long words and unknown words without digits are reported
+  void finishWord(const string &word, size_t characters, bool hasDigit, const hashTable &dictionary,
+                  vector<finding> &findings)
+  {
+    if (characters > 20)
+    {
+      findings.push_back({true, word});
+    }
+    else if (!hasDigit && !dictionary.contains(word))
+    {
+      findings.push_back({false, word});
+    }
+  }
+
+  // Tokenize a line containing UTF-8, decoding one code point at a time.
+  // Letters from isWordCodePoint join words like ASCII letters do; malformed
+  // bytes separate words. Lengths are counted in characters, not bytes.
+  void checkUtf8Line(const string &line, const hashTable &dictionary, vector<finding> &findings)
+  {
+    const char *text = line.data();
+    size_t len = line.length();
+    size_t pos = 0;
+
+    string word;
+    size_t characters = 0;
+    bool hasDigit = false;
+
+    while (pos < len)
+    {
+      uint32_t cp;
+      bool valid = decodeUtf8(text, len, pos, cp);
+      bool isWordChar = valid && (cp < 0x80 ? ((cp >= 'A' && cp <= 'Z') || (cp >= 'a' && cp <= 'z') ||
+                                               (cp >= '0' && cp <= '9') || cp == '-' || cp == '\'')
+                                            : isWordCodePoint(cp));
+      if (!isWordChar)
+      {
+        if (characters > 0)
+        {
+          finishWord(word, characters, hasDigit, dictionary, findings);
+          word.clear();
+          characters = 0;
+          hasDigit = false;
+        }
+        continue;
+      }
+
+      if (cp >= '0' && cp <= '9')
+      {
+        hasDigit = true;
+      }
+      if (cp >= 'A' && cp <= 'Z')
+      {
+        cp += 'a' - 'A';
+      }
+
+      // Keep only the first 20 characters, as the ASCII path does
+      if (characters < 20)
+      {
+        appendUtf8(word, foldCodePoint(cp));
+      }
+      characters++;
+    }
+
+    if (characters > 0)
+    {
+      finishWord(word, characters, hasDigit, dictionary, findings);
+    }
+  }
+
+  // Fold and validate len bytes from src into dst, one bit per byte in invalid.
+  // Uppercase letters are lowercased; a bit is set for every byte that is not a
+  // lowercase letter, digit, dash, apostrophe or newline.
+  void foldBlock(const char *src, char *dst, size_t len, uint64_t *invalid)
+  {
+    size_t i = 0;
+
+#ifdef __SSE2__
+    const __m128i upperLow = _mm_set1_epi8('A' - 1);
+    const __m128i upperHigh = _mm_set1_epi8('Z' + 1);
+    const __m128i lowerLow = _mm_set1_epi8('a' - 1);
+    const __m128i lowerHigh = _mm_set1_epi8('z' + 1);
+    const __m128i digitLow = _mm_set1_epi8('0' - 1);
+    const __m128i digitHigh = _mm_set1_epi8('9' + 1);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    const __m128i dash = _mm_set1_epi8('-');
+    const __m128i apostrophe = _mm_set1_epi8('\'');
+    const __m128i newline = _mm_set1_epi8('\n');
+
+    // 64 bytes per step fill exactly one word of the bitmap
+    for (; i + 64 <= len; i += 64)
+    {
+      uint64_t bits = 0;
+      for (int part = 0; part < 4; ++part)
+      {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i + part * 16));
+
+        // Bytes >= 0x80 compare as negative, so they are never in a range below
+        __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(v, upperLow), _mm_cmpgt_epi8(upperHigh, v));
+        v = _mm_or_si128(v, _mm_and_si128(isUpper, caseBit));
+
+        __m128i ok = _mm_and_si128(_mm_cmpgt_epi8(v, lowerLow), _mm_cmpgt_epi8(lowerHigh, v));
+        ok = _mm_or_si128(ok, _mm_and_si128(_mm_cmpgt_epi8(v, digitLow), _mm_cmpgt_epi8(digitHigh, v)));
+        ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, dash));
+        ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, apostrophe));
+        ok = _mm_or_si128(ok, _mm_cmpeq_epi8(v, newline));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i + part * 16), v);
+        uint64_t bad = static_cast<uint16_t>(~_mm_movemask_epi8(ok));
+        bits |= bad << (part * 16);
+      }
+      invalid[i / 64] = bits;
+    }
+#endif
+
+    // Remaining bytes (or all of them without SSE2)
+    for (; i < len; ++i)
+    {
+      char c = src[i];
+      if (c >= 'A' && c <= 'Z')
+      {
+        c += 'a' - 'A';
+      }
+      dst[i] = c;
+      if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '\'' || c == '\n'))
+      {
+        invalid[i / 64] |= uint64_t(1) << (i % 64);
+      }
+    }
+  }
+
+  // Check whether any bit in [begin, begin + len) is set; len is at most 20
+  bool anyInvalid(const uint64_t *invalid, size_t begin, size_t len)
+  {
+    size_t word = begin / 64;
+    size_t offset = begin % 64;
+    uint64_t bits = invalid[word] >> offset;
+    if (offset + len > 64)
+    {
+      bits |= invalid[word + 1] << (64 - offset);
+    }
+    return (bits & ((uint64_t(1) << len) - 1)) != 0;
+  }
+
+  // Fold and validate one newline-aligned slice of the file and collect its valid words
+  void collectWords(const char *begin, const char *end, vector<string> &words)
+  {
+    size_t len = end - begin;
+    vector<char> folded(len);
+    vector<uint64_t> invalid(len / 64 + 2, 0);
+    foldBlock(begin, folded.data(), len, invalid.data());
+
+    const char *text = folded.data();
+    string utf8Word;
+    size_t pos = 0;
+    while (pos < len)
+    {
+      const char *newline = static_cast<const char *>(memchr(text + pos, '\n', len - pos));
+      size_t lineEnd = newline ? newline - text : len;
+      size_t wordLength = lineEnd - pos;
+
+      // Skip words that are too long or contain invalid characters; words with
+      // UTF-8 letters (up to 20 characters of 4 bytes) take the slow path
+      if (wordLength > 0 && wordLength <= 20 && !anyInvalid(invalid.data(), pos, wordLength))
+      {
+        words.emplace_back(text + pos, wordLength);
+      }
+      else if (wordLength > 0 && wordLength <= 80 && !isAscii(text + pos, wordLength) &&
+               foldUtf8Word(text + pos, wordLength, 20, utf8Word))
+      {
+        words.push_back(utf8Word);
+      }
+      pos = lineEnd + 1;
+    }
+  }
+}
+
+// Load the dictionary into the hash table.
+// The file is mapped and split at line boundaries across threads, each of which
+// folds and validates its slice; the table is then built in one parallel bulk insert.
+hashTable loadDictionary(const string &dictionaryFile)
+{
+  int fd = open(dictionaryFile.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0)
+  {
+    cerr << "Error: Could not open dictionary file: " << dictionaryFile << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  // Initialize the hash table
+  hashTable dictionary(100000);
+
+  size_t size = info.st_size;
+  if (size == 0)
+  {
+    close(fd);
+    return dictionary;
+  }
+
+  void *mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (mapped == MAP_FAILED)
+  {
+    cerr << "Error: Could not map dictionary file: " << dictionaryFile << endl;
+    exit(EXIT_FAILURE);
+  }
+  madvise(mapped, size, MADV_SEQUENTIAL);
+  const char *text = static_cast<const char *>(mapped);
+
+  // Small files are not worth the thread start-up; give each thread at least 1 MB
+  size_t hardware = max(1u, thread::hardware_concurrency());
+  int threads = static_cast<int>(min(hardware, size / (1 << 20) + 1));
+
+  // Slice boundaries, each moved forward to the start of a line
+  vector<const char *> bounds(threads + 1);
+  bounds[0] = text;
+  bounds[threads] = text + size;
+  for (int t = 1; t < threads; ++t)
+  {
+    const char *guess = max(bounds[t - 1], text + size / threads * t);
+    const char *newline = static_cast<const char *>(memchr(guess, '\n', text + size - guess));
+    bounds[t] = newline ? newline + 1 : text + size;
+  }
+
+  vector<vector<string>> words(threads);
+  vector<thread> pool;
+  for (int t = 1; t < threads; ++t)
+  {
+    pool.emplace_back(collectWords, bounds[t], bounds[t + 1], ref(words[t]));
+  }
+  collectWords(bounds[0], bounds[1], words[0]);
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+  munmap(mapped, size);
+
+  // Gather the slices in file order and build the table
+  vector<string> allWords = move(words[0]);
+  for (int t = 1; t < threads; ++t)
+  {
+    allWords.insert(allWords.end(), make_move_iterator(words[t].begin()), make_move_iterator(words[t].end()));
+  }
+
+  if (dictionary.insertBulk(move(allWords), threads) < 0)
+  {
+    cerr << "Error: Rehashing failed during dictionary loading." << endl;
+    exit(EXIT_FAILURE);
+  }
+  return dictionary;
+}
+
+// Find the long and unknown words on one line
+void checkLine(const string &line, const hashTable &dictionary, vector<finding> &findings)
+{
+  // Nearly all lines are pure ASCII; only the rest need decoding
+  if (!isAscii(line.data(), line.length()))
+  {
+    checkUtf8Line(line, dictionary, findings);
+    return;
+  }
+
+  size_t i = 0;
+  size_t len = line.length();
+
+  while (i < len)
+  {
+    // Skip non-valid characters (word separators)
+    while (i < len && !(
+                          (line[i] >= 'A' && line[i] <= 'Z') ||
+                          (line[i] >= 'a' && line[i] <= 'z') ||
+                          (line[i] >= '0' && line[i] <= '9') ||
+                          line[i] == '-' || line[i] == '\''))
+    {
+      i++;
+    }
+
+    // Start of a word
+    if (i >= len)
+      break;
+
+    size_t wordStart = i;
+    size_t wordLength = 0;
+    bool hasDigit = false;
+    char wordBuffer[21]; // 20 characters max + null terminator
+
+    // Collect valid word characters
+    while (i < len && ((line[i] >= 'A' && line[i] <= 'Z') ||
+                       (line[i] >= 'a' && line[i] <= 'z') ||
+                       (line[i] >= '0' && line[i] <= '9') ||
+                       line[i] == '-' || line[i] == '\''))
+    {
+      char c = line[i];
+
+      // Check for digits
+      if (c >= '0' && c <= '9')
+      {
+        hasDigit = true;
+      }
+
+      // Convert uppercase letters to lowercase
+      if (c >= 'A' && c <= 'Z')
+      {
+        c = c + ('a' - 'A'); // Convert to lowercase
+      }
+
+      // Add character to word buffer if within length limit
+      if (wordLength < 20)
+      {
+        wordBuffer[wordLength++] = c;
+      }
+
+      i++;
+    }
+
+    size_t totalWordLength = i - wordStart;
+
+    // Process the word
+    if (totalWordLength > 20)
+    {
+      findings.push_back({true, string(wordBuffer, 20)});
+    }
+    else if (!hasDigit)
+    {
+      wordBuffer[wordLength] = '\0'; // Null-terminate the word
+
+      if (!dictionary.contains(string(wordBuffer)))
+      {
+        findings.push_back({false, string(wordBuffer, wordLength)});
+      }
+    }
+  }
+}
+
+// Write one report line per finding, numbered with the given line
+void writeFindings(ostream &out, int lineNumber, const vector<finding> &findings)
+{
+  if (findings.empty())
+  {
+    return;
+  }
+
+  // Format the number once and write each report line in a single call
+  char number[16];
+  size_t numberLength = to_chars(number, number + sizeof(number), lineNumber).ptr - number;
+  string report;
+  for (const auto &f : findings)
+  {
+    report.assign(f.isLong ? "Long word at line " : "Unknown word at line ");
+    report.append(number, numberLength);
+    report.append(f.isLong ? ", starts: " : ": ");
+    report.append(f.word);
+    report += '\n';
+    out.write(report.data(), report.size());
+  }
+}
+
+// Check each line of the document and report long and unknown words
+void checkDocument(istream &in, ostream &out, const hashTable &dictionary)
+{
+  string line;
+  vector<finding> findings;
+  int lineNumber = 1;
+
+  // Process each line in the input file
+  while (getline(in, line))
+  {
+    findings.clear();
+    checkLine(line, dictionary, findings);
+    writeFindings(out, lineNumber, findings);
+    lineNumber++;
+  }
+}
@@ -0,0 +1,37 @@
+#ifndef _CHECKER_H
+#define _CHECKER_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include "hash.h"
+
+// A long or unknown word found on one line of a document
+struct finding
+{
+  bool isLong;      // True for a word over 20 characters, false for an unknown word
+  std::string word; // The unknown word, or the first 20 characters of the long word
+};
+
+// Load the dictionary file into a new hash table.
+// Words longer than 20 characters or containing characters other than
+// letters, digits, dashes and apostrophes are skipped; letters are lowercased.
+// Letters may be ASCII or UTF-8 Latin, Greek and Cyrillic (see utf8.h).
+// Exits the program if the file cannot be opened or the table cannot grow.
+hashTable loadDictionary(const std::string &dictionaryFile);
+
+// Check one line and append its long and unknown words to findings, in order.
+// Pure-ASCII lines take a fast path; other lines are decoded as UTF-8.
+// The result depends only on the line's text, never on its position.
+void checkLine(const std::string &line, const hashTable &dictionary, std::vector<finding> &findings);
+
+// Write the report lines for one line's findings, numbered lineNumber.
+void writeFindings(std::ostream &out, int lineNumber, const std::vector<finding> &findings);
+
+// Check every line of the document read from in against the dictionary
+// and write one report line per long or unknown word to out.
+// The dictionary is only read, so several threads may check
+// different documents against the same table at once.
+void checkDocument(std::istream &in, std::ostream &out, const hashTable &dictionary);
+
+#endif //_CHECKER_H
@@ -0,0 +1,338 @@
+/* Name: Talha Akhlaq
+Description: This file implements the spell-check daemon, which loads the dictionary once and answers
+check requests over a Unix domain socket from a fixed pool of worker threads, plus the client helpers.
+*/
+
+#include "daemon.h"
+#include "checker.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <deque>
+#include <algorithm>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+
+using namespace std;
+
+namespace
+{
+  // Largest document one request may carry
+  const size_t requestLimit = 64 << 20;
+
+  // Seconds a client may stay silent before its connection is dropped
+  const int clientTimeout = 10;
+
+  // Set by the signal handler; polled by the accept loop
+  volatile sig_atomic_t stopRequested = 0;
+
+  void onStopSignal(int)
+  {
+    stopRequested = 1;
+  }
+
+  // Accepted connections waiting for a worker
+  class connectionQueue
+  {
+  public:
+    // Add a connection and wake one worker
+    void push(int fd)
+    {
+      {
+        lock_guard<mutex> lock(m);
+        fds.push_back(fd);
+      }
+      ready.notify_one();
+    }
+
+    // Wait for a connection; returns false once the queue is closed and drained
+    bool pop(int &fd)
+    {
+      unique_lock<mutex> lock(m);
+      ready.wait(lock, [this]
+                 { return closed || !fds.empty(); });
+      if (fds.empty())
+      {
+        return false;
+      }
+      fd = fds.front();
+      fds.pop_front();
+      return true;
+    }
+
+    // Stop accepting work and wake all workers
+    void close()
+    {
+      {
+        lock_guard<mutex> lock(m);
+        closed = true;
+      }
+      ready.notify_all();
+    }
+
+  private:
+    mutex m;
+    condition_variable ready;
+    deque<int> fds;
+    bool closed{false};
+  };
+
+  // Fill in a Unix socket address; returns false if the path does not fit
+  bool makeAddress(const string &socketPath, sockaddr_un &addr)
+  {
+    if (socketPath.size() >= sizeof(addr.sun_path))
+    {
+      return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    return true;
+  }
+
+  // Read and discard the rest of an oversized request, up to another requestLimit bytes, so the
+  // client can finish sending and read the error instead of having its connection reset
+  void drainRequest(int fd)
+  {
+    char buf[65536];
+    size_t left = requestLimit;
+    while (left > 0)
+    {
+      ssize_t got = recv(fd, buf, sizeof(buf), 0);
+      if (got == 0)
+      {
+        return;
+      }
+      if (got < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return;
+      }
+      left -= min(left, static_cast<size_t>(got));
+    }
+  }
+
+  // Read one document, check it, and write the report back
+  void serveConnection(int fd, const hashTable &dictionary)
+  {
+    // A stalled client must not hold a worker forever
+    timeval timeout = {clientTimeout, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    string document;
+    bool tooLarge = false;
+    if (recvAll(fd, document, requestLimit, &tooLarge))
+    {
+      istringstream in(document);
+      ostringstream out;
+      checkDocument(in, out, dictionary);
+      string report = out.str();
+      sendAll(fd, report.data(), report.size());
+    }
+    else if (tooLarge)
+    {
+      drainRequest(fd);
+      string reply = "Error: Document exceeds " + to_string(requestLimit >> 20) + " MB\n";
+      sendAll(fd, reply.data(), reply.size());
+    }
+    close(fd);
+  }
+
+  // Serve queued connections until the queue is closed
+  void workerLoop(connectionQueue &queue, const hashTable &dictionary)
+  {
+    int fd;
+    while (queue.pop(fd))
+    {
+      serveConnection(fd, dictionary);
+    }
+  }
+}
+
+// Listen on the socket and hand connections to the worker pool until stopped
+int runDaemon(const string &socketPath, const hashTable &dictionary, int workers)
+{
+  sockaddr_un addr;
+  if (!makeAddress(socketPath, addr))
+  {
+    cerr << "Error: Socket path is too long: " << socketPath << endl;
+    return 1;
+  }
+
+  int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFd < 0)
+  {
+    cerr << "Error: Could not create socket: " << strerror(errno) << endl;
+    return 1;
+  }
+
+  unlink(socketPath.c_str()); // Remove a stale socket left by an earlier run
+  if (bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listenFd, 128) != 0)
+  {
+    cerr << "Error: Could not listen on " << socketPath << ": " << strerror(errno) << endl;
+    close(listenFd);
+    return 1;
+  }
+
+  // Stop cleanly on SIGINT/SIGTERM; a client hanging up must not kill the daemon
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = onStopSignal;
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+  signal(SIGPIPE, SIG_IGN);
+
+  if (workers < 1)
+  {
+    workers = 1;
+  }
+
+  connectionQueue queue;
+  vector<thread> pool;
+  for (int i = 0; i < workers; ++i)
+  {
+    pool.emplace_back(workerLoop, ref(queue), cref(dictionary));
+  }
+
+  cout << "Listening on " << socketPath << " with " << workers << " workers" << endl;
+
+  while (!stopRequested)
+  {
+    // Wake up periodically so a stop signal is noticed even when idle
+    pollfd pfd = {listenFd, POLLIN, 0};
+    int ready = poll(&pfd, 1, 200);
+    if (ready <= 0)
+    {
+      continue;
+    }
+
+    int client = accept(listenFd, nullptr, nullptr);
+    if (client < 0)
+    {
+      if (errno == EINTR || errno == ECONNABORTED)
+      {
+        continue;
+      }
+      cerr << "Error: accept failed: " << strerror(errno) << endl;
+      break;
+    }
+    queue.push(client);
+  }
+
+  // Let the workers finish the requests already accepted
+  queue.close();
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+
+  close(listenFd);
+  unlink(socketPath.c_str());
+  return 0;
+}
+
+// Connect to the daemon's socket
+int connectDaemon(const string &socketPath)
+{
+  sockaddr_un addr;
+  if (!makeAddress(socketPath, addr))
+  {
+    return -1;
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0)
+  {
+    return -1;
+  }
+  if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+  {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Send the whole buffer, retrying short writes
+bool sendAll(int fd, const char *buf, size_t len)
+{
+  while (len > 0)
+  {
+    ssize_t sent = send(fd, buf, len, MSG_NOSIGNAL);
+    if (sent < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    buf += sent;
+    len -= sent;
+  }
+  return true;
+}
+
+// Read until the peer shuts down its write side or the limit is passed
+bool recvAll(int fd, string &out, size_t limit, bool *tooLarge)
+{
+  char buf[65536];
+  while (true)
+  {
+    if (out.size() > limit)
+    {
+      if (tooLarge != nullptr)
+      {
+        *tooLarge = true;
+      }
+      return false;
+    }
+    ssize_t got = recv(fd, buf, sizeof(buf), 0);
+    if (got == 0)
+    {
+      return true;
+    }
+    if (got < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      return false;
+    }
+    out.append(buf, got);
+  }
+}
+
+// One request/response round trip
+int checkRemote(const string &socketPath, const string &document, string &report)
+{
+  int fd = connectDaemon(socketPath);
+  if (fd < 0)
+  {
+    return 1;
+  }
+
+  report.clear();
+  bool ok = sendAll(fd, document.data(), document.size()) &&
+            shutdown(fd, SHUT_WR) == 0 &&
+            recvAll(fd, report);
+  close(fd);
+  return ok ? 0 : 2;
+}
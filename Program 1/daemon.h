@@ -0,0 +1,35 @@
+#ifndef _DAEMON_H
+#define _DAEMON_H
+
+#include <string>
+#include <cstdint>
+#include "hash.h"
+
+// Serve spell-check requests on a Unix domain socket until SIGINT or SIGTERM.
+// Each connection carries one document: the client sends the document bytes,
+// shuts down its write side, and reads the report back until end of file.
+// Connections are handled by a pool of workers sharing the loaded dictionary.
+// A client silent for 10 seconds, or sending more than 64 MB, is disconnected.
+// Returns 0 on a clean shutdown, 1 if the socket could not be set up.
+int runDaemon(const std::string &socketPath, const hashTable &dictionary, int workers);
+
+// Connect to a daemon listening on socketPath.
+// Returns the connected socket, or -1 on failure.
+int connectDaemon(const std::string &socketPath);
+
+// Send all len bytes of buf over the socket.
+// Returns true on success, false on error.
+bool sendAll(int fd, const char *buf, size_t len);
+
+// Read from the socket until end of file, appending to out.
+// Stops once more than limit bytes have been read, setting *tooLarge if given.
+// Returns true on success, false on error, timeout or an oversized message.
+bool recvAll(int fd, std::string &out, size_t limit = SIZE_MAX, bool *tooLarge = nullptr);
+
+// Send one document to the daemon and store its report.
+// Returns 0 on success,
+// 1 if the daemon could not be reached,
+// 2 if the request failed part way.
+int checkRemote(const std::string &socketPath, const std::string &document, std::string &report);
+
+#endif //_DAEMON_H
@@ -8,6 +8,9 @@ linear probing for collision resolution and rehashing triggered when the load fa
 #include <vector>
 #include <string>
 #include <stdexcept>
+#include <thread>
+#include <algorithm>
+#include <utility>
 
 // Precomputed prime numbers for rehashing
 const unsigned int primeNumbers[] = {53, 97, 193, 389, 769, 1543, 3079, 6151, 12289, 24593, 49157, 98317,
@@ -36,7 +39,7 @@ hashTable::hashTable(int size) : data(getPrime(size))
 }
 
 // Polynomial rolling hash function for strings
-unsigned int hashTable::hash(const std::string &key)
+unsigned int hashTable::hash(const std::string &key) const
 {
   unsigned int hash_value = 0;
   const unsigned int prime = 37;
@@ -48,7 +51,7 @@ unsigned int hashTable::hash(const std::string &key)
 }
 
 // Finds the position of the key using linear probing
-int hashTable::findPos(const std::string &key)
+int hashTable::findPos(const std::string &key) const
 {
   int hashIndex = hash(key);
   int startIdx = hashIndex;
@@ -125,29 +128,153 @@ bool hashTable::rehash()
         return false;
     }
 
+    rebuild(newCapacity);
+    return true;
+}
+
+// Reinserts all live items into a fresh table of the given capacity
+void hashTable::rebuild(int newCapacity)
+{
     capacity = newCapacity;
-    std::vector<hashItem> oldData = data;
+    std::vector<hashItem> oldData = std::move(data);
     data = std::vector<hashItem>(capacity);
     filled = 0;
 
-    for (const auto &item : oldData)
+    for (auto &item : oldData)
     {
         if (item.isOccupied && !item.isDeleted)
         {
             insert(item.key, item.pv, true); // Bypass flag to prevent rehashing
         }
     }
-    return true;
+}
+
+// Inserts a batch of keys, filling disjoint regions of the table in parallel
+int hashTable::insertBulk(std::vector<std::string> keys, int threads)
+{
+  // Grow once so the whole batch fits under the load factor
+  int needed = static_cast<int>((filled + keys.size()) / loadFactor) + 1;
+  if (needed > capacity)
+  {
+    int newCapacity = getPrime(needed);
+    if (newCapacity < needed)
+    {
+      return -1;
+    }
+    rebuild(newCapacity);
+  }
+
+  if (threads < 1)
+  {
+    threads = 1;
+  }
+
+  // Region r owns slots [r * regionSize, (r + 1) * regionSize)
+  int regionSize = (capacity + threads - 1) / threads;
+  size_t keysPerThread = (keys.size() + threads - 1) / threads;
+
+  // byRegion[t][r] lists the keys hashed by thread t whose home slot is in region r
+  std::vector<std::vector<std::vector<std::pair<size_t, int>>>> byRegion(threads, std::vector<std::vector<std::pair<size_t, int>>>(threads));
+  std::vector<std::vector<size_t>> deferred(threads);
+  std::vector<int> inserted(threads, 0);
+
+  auto hashKeys = [&](int t)
+  {
+    size_t end = std::min(keys.size(), (t + 1) * keysPerThread);
+    for (auto &list : byRegion[t])
+    {
+      list.reserve(keysPerThread / threads + 16);
+    }
+    for (size_t i = t * keysPerThread; i < end; ++i)
+    {
+      int home = hash(keys[i]);
+      byRegion[t][home / regionSize].push_back({i, home});
+    }
+  };
+
+  auto fillRegion = [&](int r)
+  {
+    int regionBegin = r * regionSize;
+    int regionEnd = std::min(capacity, regionBegin + regionSize);
+
+    for (int t = 0; t < threads; ++t)
+    {
+      for (const auto &entry : byRegion[t][r])
+      {
+        std::string &key = keys[entry.first];
+        int pos = entry.second;
+
+        // Probe only inside this region; deleted slots are stepped over, never reused
+        while (pos < regionEnd && data[pos].isOccupied && !(!data[pos].isDeleted && data[pos].key == key))
+        {
+          pos++;
+        }
+
+        if (pos >= regionEnd)
+        {
+          deferred[r].push_back(entry.first); // Probe would cross into another region
+        }
+        else if (!data[pos].isOccupied)
+        {
+          data[pos].key = std::move(key);
+          data[pos].isOccupied = true;
+          inserted[r]++;
+        }
+      }
+    }
+  };
+
+  std::vector<std::thread> pool;
+  for (int t = 1; t < threads; ++t)
+  {
+    pool.emplace_back(hashKeys, t);
+  }
+  hashKeys(0);
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+
+  pool.clear();
+  for (int r = 1; r < threads; ++r)
+  {
+    pool.emplace_back(fillRegion, r);
+  }
+  fillRegion(0);
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+
+  int total = 0;
+  for (int r = 0; r < threads; ++r)
+  {
+    filled += inserted[r];
+    total += inserted[r];
+  }
+
+  // Keys that overflowed their region go in serially, with normal wraparound probing
+  for (const auto &list : deferred)
+  {
+    for (size_t i : list)
+    {
+      if (insert(keys[i], nullptr, true) == 0)
+      {
+        total++;
+      }
+    }
+  }
+  return total;
 }
 
 // Checks if a key exists in the table
-bool hashTable::contains(const std::string &key)
+bool hashTable::contains(const std::string &key) const
 {
   return findPos(key) != -1;
 }
 
 // Returns the pointer associated with the key, if found
-void *hashTable::getPointer(const std::string &key, bool *b)
+void *hashTable::getPointer(const std::string &key, bool *b) const
 {
   int pos = findPos(key);
   if (b != nullptr)
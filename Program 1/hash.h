@@ -23,14 +23,25 @@ int insert(const std::string &key, void *pv = nullptr, bool duringRehash = false
 
   // Check if the specified key is in the hash table.
   // If so, return true; otherwise, return false.
-  bool contains(const std::string &key);
+  // Lookups never modify the table, so a fully loaded table
+  // may be shared by any number of reader threads.
+  bool contains(const std::string &key) const;
 
   // Get the pointer associated with the specified key.
   // If the key does not exist in the hash table, return nullptr.
   // If an optional pointer to a bool is provided,
   // set the bool to true if the key is in the hash table,
   // and set the bool to false otherwise.
-  void *getPointer(const std::string &key, bool *b = nullptr);
+  void *getPointer(const std::string &key, bool *b = nullptr) const;
+
+  // Insert many keys at once, with no associated pointers.
+  // The table is grown up front so no rehash happens during the build,
+  // and the keys are split by home slot so each thread fills its own
+  // region of the table; keys whose probe leaves that region are
+  // inserted one at a time afterwards. Duplicates are skipped.
+  // The keys are moved into the table.
+  // Returns the number of keys inserted, or -1 if the table cannot grow.
+  int insertBulk(std::vector<std::string> keys, int threads = 1);
 
   // Set the pointer associated with the specified key.
   // Returns 0 on success,
@@ -68,16 +79,19 @@ private:
   std::vector<hashItem> data; // The actual entries are here.
 
   // The hash function.
-  unsigned int hash(const std::string &key);
+  unsigned int hash(const std::string &key) const;
 
   // Search for an item with the specified key.
   // Return the position if found, -1 otherwise.
-  int findPos(const std::string &key);
+  int findPos(const std::string &key) const;
 
   // The rehash function; makes the hash table bigger.
   // Returns true on success, false if memory allocation fails.
   bool rehash();
 
+  // Move every live item into a new table of the specified capacity.
+  void rebuild(int newCapacity);
+
   // Return a prime number at least as large as size.
   // Uses a precomputed sequence of selected prime numbers.
   static unsigned int getPrime(int size);
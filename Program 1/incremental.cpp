@@ -0,0 +1,217 @@
+/* Name: Talha Akhlaq
+Description: This file implements incremental re-checking. Each line's content hash and findings are kept
+from the previous run (in memory or in a state file), so after an edit only new or changed lines are checked.
+*/
+
+#include "incremental.h"
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+
+using namespace std;
+
+namespace
+{
+  // Identifies the state file format; bumped whenever tokenization or folding changes what a chunk finds
+  const char stateMagic[] = "spellcheck-state 2\n";
+
+  template <typename T>
+  void writeValue(ostream &out, T value)
+  {
+    out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  template <typename T>
+  bool readValue(istream &in, T &value)
+  {
+    return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+  }
+
+  void writeString(ostream &out, const string &s)
+  {
+    writeValue<uint32_t>(out, s.size());
+    out.write(s.data(), s.size());
+  }
+
+  bool readString(istream &in, string &s)
+  {
+    uint32_t size;
+    if (!readValue(in, size) || size > (1u << 20))
+    {
+      return false;
+    }
+    s.resize(size);
+    return static_cast<bool>(in.read(&s[0], size));
+  }
+}
+
+incrementalChecker::incrementalChecker(const hashTable &dictionary, const string &dictionaryTag)
+    : dictionary(dictionary), dictionaryTag(dictionaryTag)
+{
+}
+
+// 64-bit FNV-1a over the line's bytes
+uint64_t incrementalChecker::hashLine(const string &line)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (char c : line)
+  {
+    hash ^= static_cast<unsigned char>(c);
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+// Check only the lines not seen in the previous run, then write the full report
+int incrementalChecker::check(istream &in, ostream &out)
+{
+  vector<string> text;
+  string line;
+  while (getline(in, line))
+  {
+    text.push_back(move(line));
+  }
+
+  size_t newCount = text.size();
+  size_t oldCount = lines.size();
+  vector<uint64_t> hashes(newCount);
+  for (size_t i = 0; i < newCount; ++i)
+  {
+    hashes[i] = hashLine(text[i]);
+  }
+
+  // Unchanged lines at the start and end keep their results in place
+  size_t prefix = 0;
+  while (prefix < newCount && prefix < oldCount && hashes[prefix] == lines[prefix].hash)
+  {
+    prefix++;
+  }
+  size_t suffix = 0;
+  while (suffix < newCount - prefix && suffix < oldCount - prefix &&
+         hashes[newCount - 1 - suffix] == lines[oldCount - 1 - suffix].hash)
+  {
+    suffix++;
+  }
+
+  // Lines in the edited middle can reuse an old middle line with the same content,
+  // which covers lines that were moved, copied or reverted
+  unordered_map<uint64_t, size_t> oldByHash;
+  oldByHash.reserve(oldCount - prefix - suffix);
+  for (size_t i = prefix; i < oldCount - suffix; ++i)
+  {
+    oldByHash.emplace(lines[i].hash, i);
+  }
+
+  vector<lineResult> results(newCount);
+  int rechecked = 0;
+  for (size_t i = prefix; i < newCount - suffix; ++i)
+  {
+    results[i].hash = hashes[i];
+    auto it = oldByHash.find(hashes[i]);
+    if (it != oldByHash.end())
+    {
+      results[i].findings = lines[it->second].findings;
+    }
+    else
+    {
+      checkLine(text[i], dictionary, results[i].findings);
+      rechecked++;
+    }
+  }
+
+  // Move the untouched ends last, after the middle has copied what it needs
+  for (size_t i = 0; i < prefix; ++i)
+  {
+    results[i] = move(lines[i]);
+  }
+  for (size_t i = 0; i < suffix; ++i)
+  {
+    results[newCount - 1 - i] = move(lines[oldCount - 1 - i]);
+  }
+
+  lines = move(results);
+  for (size_t i = 0; i < newCount; ++i)
+  {
+    writeFindings(out, static_cast<int>(i + 1), lines[i].findings);
+  }
+  return rechecked;
+}
+
+// Save the hashes and findings so a later process can continue incrementally
+bool incrementalChecker::save(const string &stateFile) const
+{
+  ofstream out(stateFile, ios::binary);
+  if (!out.is_open())
+  {
+    return false;
+  }
+
+  out.write(stateMagic, sizeof(stateMagic) - 1);
+  writeString(out, dictionaryTag);
+  writeValue<uint64_t>(out, lines.size());
+  for (const auto &result : lines)
+  {
+    writeValue<uint64_t>(out, result.hash);
+    writeValue<uint32_t>(out, result.findings.size());
+    for (const auto &f : result.findings)
+    {
+      writeValue<uint8_t>(out, f.isLong);
+      writeString(out, f.word);
+    }
+  }
+  return static_cast<bool>(out);
+}
+
+// Restore the results of an earlier run, discarding them if anything does not match
+bool incrementalChecker::load(const string &stateFile)
+{
+  lines.clear();
+
+  ifstream in(stateFile, ios::binary);
+  if (!in.is_open())
+  {
+    return false;
+  }
+
+  string magic(sizeof(stateMagic) - 1, '\0');
+  string tag;
+  uint64_t count;
+  if (!in.read(&magic[0], magic.size()) || magic != stateMagic ||
+      !readString(in, tag) || tag != dictionaryTag || !readValue(in, count))
+  {
+    return false;
+  }
+
+  vector<lineResult> loaded;
+  for (uint64_t i = 0; i < count; ++i)
+  {
+    lineResult result;
+    uint32_t findingCount;
+    if (!readValue(in, result.hash) || !readValue(in, findingCount))
+    {
+      return false;
+    }
+    for (uint32_t j = 0; j < findingCount; ++j)
+    {
+      uint8_t isLong;
+      finding f;
+      if (!readValue(in, isLong) || !readString(in, f.word))
+      {
+        return false;
+      }
+      f.isLong = isLong != 0;
+      result.findings.push_back(move(f));
+    }
+    loaded.push_back(move(result));
+  }
+
+  lines = move(loaded);
+  return true;
+}
+
+int incrementalChecker::lineCount() const
+{
+  return static_cast<int>(lines.size());
+}
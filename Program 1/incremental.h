@@ -0,0 +1,55 @@
+#ifndef _INCREMENTAL_H
+#define _INCREMENTAL_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "checker.h"
+#include "hash.h"
+
+// Re-checks edited documents, only spell-checking lines whose content changed.
+// Every line's findings depend only on its text, so results from the previous
+// run are reused by content hash wherever the line now sits, and are simply
+// renumbered when lines above it were inserted or deleted.
+class incrementalChecker
+{
+public:
+  // The tag identifies the dictionary; saved state with a different tag is ignored.
+  incrementalChecker(const hashTable &dictionary, const std::string &dictionaryTag = "");
+
+  // Check the document and write the same report a full run would produce.
+  // The document's lines and results replace the previous ones.
+  // Returns the number of lines that had to be checked.
+  int check(std::istream &in, std::ostream &out);
+
+  // Write the current lines' hashes and results to the state file.
+  // Returns true on success, false if the file cannot be written.
+  bool save(const std::string &stateFile) const;
+
+  // Read the results of an earlier run from the state file.
+  // Returns true on success, false if the file is missing, corrupt,
+  // or was written with a different dictionary (previous results are then empty).
+  bool load(const std::string &stateFile);
+
+  // Number of lines in the most recent document.
+  int lineCount() const;
+
+private:
+  // Results for one line of the previous document
+  class lineResult
+  {
+  public:
+    uint64_t hash;                 // FNV-1a hash of the line's text
+    std::vector<finding> findings; // What checkLine found on it
+  };
+
+  const hashTable &dictionary;
+  std::string dictionaryTag;
+  std::vector<lineResult> lines; // Results for the previous run, in line order
+
+  // 64-bit FNV-1a hash of a line's text.
+  static uint64_t hashLine(const std::string &line);
+};
+
+#endif //_INCREMENTAL_H
@@ -0,0 +1,242 @@
+/* Name: Talha Akhlaq
+Description: This program is a load generator for the spell-check daemon. It opens several concurrent
+clients that repeatedly submit the same document, then reports throughput and latency percentiles.
+With --incremental it instead compares full and incremental re-checks of a document after small edits.
+Usage: spellbench <socket> <document> [clients] [requests per client]
+       spellbench --incremental <dictionary> <document> [edited lines per round] [rounds]
+*/
+
+#include "daemon.h"
+#include "checker.h"
+#include "incremental.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <iomanip>
+#include <cstdlib>
+#include <random>
+
+using namespace std;
+using namespace std::chrono;
+
+// Per-client results, merged after all clients finish
+struct clientResult
+{
+  vector<double> latencies; // Seconds per successful request
+  int failures{0};          // Requests that could not be completed
+  int mismatches{0};        // Reports that differ from the first one seen
+};
+
+// Submit the document count times and time each round trip
+void runClient(const string &socketPath, const string &document, int count, const string &expected, clientResult &result)
+{
+  string report;
+  result.latencies.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    auto start = steady_clock::now();
+    int status = checkRemote(socketPath, document, report);
+    auto end = steady_clock::now();
+
+    if (status != 0)
+    {
+      result.failures++;
+      continue;
+    }
+    if (report != expected)
+    {
+      result.mismatches++;
+    }
+    result.latencies.push_back(duration_cast<duration<double>>(end - start).count());
+  }
+}
+
+// Value at the given percentile of sorted samples
+double percentile(const vector<double> &sorted, double p)
+{
+  if (sorted.empty())
+  {
+    return 0.0;
+  }
+  size_t index = static_cast<size_t>(p / 100.0 * (sorted.size() - 1) + 0.5);
+  return sorted[index];
+}
+
+// Join lines back into a document
+string joinLines(const vector<string> &lines)
+{
+  string document;
+  for (const auto &line : lines)
+  {
+    document += line;
+    document += '\n';
+  }
+  return document;
+}
+
+// Apply small edits to the document and time a full check against an incremental one each round
+int incrementalBenchmark(int argc, char *argv[])
+{
+  if (argc < 4)
+  {
+    cerr << "Usage: " << argv[0] << " --incremental <dictionary> <document> [edited lines per round] [rounds]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  int edits = (argc > 4) ? atoi(argv[4]) : 5;
+  int rounds = (argc > 5) ? atoi(argv[5]) : 20;
+
+  ifstream inputStream(argv[3]);
+  if (!inputStream.is_open())
+  {
+    cerr << "Error: Could not open document: " << argv[3] << endl;
+    return EXIT_FAILURE;
+  }
+  vector<string> lines;
+  string line;
+  while (getline(inputStream, line))
+  {
+    lines.push_back(line);
+  }
+  if (lines.empty())
+  {
+    cerr << "Error: Document is empty" << endl;
+    return EXIT_FAILURE;
+  }
+
+  hashTable dictionary = loadDictionary(argv[2]);
+  incrementalChecker checker(dictionary);
+
+  // The first incremental run has nothing to reuse
+  {
+    istringstream in(joinLines(lines));
+    ostringstream out;
+    checker.check(in, out);
+  }
+
+  mt19937 rng(365);
+  double fullTime = 0;
+  double incrementalTime = 0;
+  long rechecked = 0;
+  int mismatches = 0;
+
+  for (int round = 0; round < rounds; ++round)
+  {
+    // Change a few lines, and insert and delete one so later line numbers shift
+    for (int e = 0; e < edits; ++e)
+    {
+      lines[rng() % lines.size()] += " qzxv" + to_string(round);
+    }
+    lines.insert(lines.begin() + rng() % lines.size(), "Inserted line " + to_string(round) + " frobnicate");
+    lines.erase(lines.begin() + rng() % lines.size());
+    string document = joinLines(lines);
+
+    istringstream fullIn(document);
+    ostringstream fullOut;
+    auto start = steady_clock::now();
+    checkDocument(fullIn, fullOut, dictionary);
+    auto middle = steady_clock::now();
+
+    istringstream incrementalIn(document);
+    ostringstream incrementalOut;
+    rechecked += checker.check(incrementalIn, incrementalOut);
+    auto end = steady_clock::now();
+
+    fullTime += duration_cast<duration<double>>(middle - start).count();
+    incrementalTime += duration_cast<duration<double>>(end - middle).count();
+    if (fullOut.str() != incrementalOut.str())
+    {
+      mismatches++;
+    }
+  }
+
+  cout << fixed << setprecision(3);
+  cout << "Lines: " << lines.size() << ", rounds: " << rounds << ", per round: " << edits << " lines edited, 1 inserted and 1 deleted"
+       << ", mismatched reports: " << mismatches << endl;
+  cout << "Average lines re-checked: " << double(rechecked) / rounds << endl;
+  cout << "Full check (ms): " << fullTime / rounds * 1000
+       << ", incremental check (ms): " << incrementalTime / rounds * 1000
+       << ", speedup: " << fullTime / incrementalTime << "x" << endl;
+
+  return mismatches == 0 ? 0 : EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc > 1 && string(argv[1]) == "--incremental")
+  {
+    return incrementalBenchmark(argc, argv);
+  }
+
+  if (argc < 3)
+  {
+    cerr << "Usage: " << argv[0] << " <socket> <document> [clients] [requests per client]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  string socketPath = argv[1];
+  int clients = (argc > 3) ? atoi(argv[3]) : 4;
+  int requests = (argc > 4) ? atoi(argv[4]) : 1000;
+  if (clients < 1 || requests < 1)
+  {
+    cerr << "Error: clients and requests must be positive" << endl;
+    return EXIT_FAILURE;
+  }
+
+  ifstream inputStream(argv[2], ios::binary);
+  if (!inputStream.is_open())
+  {
+    cerr << "Error: Could not open document: " << argv[2] << endl;
+    return EXIT_FAILURE;
+  }
+  ostringstream buffer;
+  buffer << inputStream.rdbuf();
+  string document = buffer.str();
+
+  // One warm-up request doubles as the reference report every response is compared to
+  string expected;
+  if (checkRemote(socketPath, document, expected) != 0)
+  {
+    cerr << "Error: Could not reach daemon at " << socketPath << endl;
+    return EXIT_FAILURE;
+  }
+
+  vector<clientResult> results(clients);
+  vector<thread> threads;
+  auto start = steady_clock::now();
+  for (int i = 0; i < clients; ++i)
+  {
+    threads.emplace_back(runClient, cref(socketPath), cref(document), requests, cref(expected), ref(results[i]));
+  }
+  for (auto &t : threads)
+  {
+    t.join();
+  }
+  double elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+  vector<double> latencies;
+  int failures = 0;
+  int mismatches = 0;
+  for (const auto &result : results)
+  {
+    latencies.insert(latencies.end(), result.latencies.begin(), result.latencies.end());
+    failures += result.failures;
+    mismatches += result.mismatches;
+  }
+  sort(latencies.begin(), latencies.end());
+
+  cout << fixed << setprecision(3);
+  cout << "Clients: " << clients << ", requests: " << latencies.size()
+       << ", failures: " << failures << ", mismatched reports: " << mismatches << endl;
+  cout << "Requests/sec: " << latencies.size() / elapsed << endl;
+  cout << "Latency (ms) p50: " << percentile(latencies, 50) * 1000
+       << ", p99: " << percentile(latencies, 99) * 1000
+       << ", max: " << (latencies.empty() ? 0.0 : latencies.back() * 1000) << endl;
+
+  return (failures == 0 && mismatches == 0) ? 0 : EXIT_FAILURE;
+}
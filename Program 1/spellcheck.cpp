@@ -1,183 +1,179 @@
 /* Name: Talha Akhlaq
 Description: This program implements a spell-checker using a hash table to load a dictionary
 and checks an input document for invalid words, reporting results to an output file.
+With --daemon it instead keeps the dictionary loaded and serves documents over a Unix socket,
+with --batch it checks a whole manifest or directory of documents against one loaded dictionary,
+and with --incremental it re-checks only the lines that changed since the previous run.
 */
 
 #include "hash.h"
+#include "checker.h"
+#include "daemon.h"
+#include "batch.h"
+#include "incremental.h"
 #include <iostream>
 #include <fstream>
 #include <string>
-#include <ctime>
-#include <algorithm>
-#include <cctype>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include <chrono>
+#include <filesystem>
+#include <sys/stat.h>
 
 using namespace std;
 
-// Load the dictionary into the hash table
-hashTable loadDictionary(const string &dictionaryFile)
+// Spell-check the input file and write results to the output file
+void spellCheck(const string &inputFile, const string &outputFile, hashTable &dictionary)
 {
-  ifstream dictStream(dictionaryFile);
+  ifstream inputStream(inputFile);
+  ofstream outputStream(outputFile);
 
-  if (!dictStream.is_open())
+  if (!inputStream.is_open())
+  {
+    cerr << "Error: Could not open input file: " << inputFile << endl;
+    exit(EXIT_FAILURE);
+  }
+  if (!outputStream.is_open())
   {
-    cerr << "Error: Could not open dictionary file: " << dictionaryFile << endl;
+    cerr << "Error: Could not open output file: " << outputFile << endl;
     exit(EXIT_FAILURE);
   }
 
-  // Initialize the hash table
-  hashTable dictionary(100000);
+  checkDocument(inputStream, outputStream, dictionary);
+
+  inputStream.close();
+  outputStream.close();
+}
 
-  string word;
-  while (getline(dictStream, word))
+// Load the dictionary once and serve check requests until stopped
+int daemonMode(int argc, char *argv[])
+{
+  if (argc < 4)
   {
-    // Early length check to skip words that are too long
-    if (word.length() > 20)
-    {
-      continue;
-    }
-
-    bool isValid = true;
-
-    // Process each character in the word
-    for (size_t i = 0; i < word.length(); ++i)
-    {
-      char &c = word[i];
-
-      // Convert to lowercase if it's an uppercase letter (A-Z)
-      if (c >= 'A' && c <= 'Z')
-      {
-        c += 'a' - 'A';
-      }
-
-      // Check for invalid characters: anything other than lowercase letters, digits, dash, or apostrophe
-      if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '\''))
-      {
-        isValid = false; // Invalid character found
-        break;           // No need to check further characters, break early
-      }
-    }
-
-    // Insert valid words into the hash table
-    if (isValid)
-    {
-      int result = dictionary.insert(word);
-      if (result == 2)
-      {
-        cerr << "Error: Rehashing failed during dictionary loading." << endl;
-        exit(EXIT_FAILURE);
-      }
-    }
+    cerr << "Usage: " << argv[0] << " --daemon <dictionary> <socket> [workers]" << endl;
+    return EXIT_FAILURE;
   }
 
-  dictStream.close();
-  return dictionary;
+  int workers = (argc > 4) ? atoi(argv[4]) : static_cast<int>(thread::hardware_concurrency());
+
+  auto startTime = chrono::steady_clock::now();
+  hashTable dictionary = loadDictionary(argv[2]);
+  auto endTime = chrono::steady_clock::now();
+  double dictLoadTime = chrono::duration<double>(endTime - startTime).count();
+  cout << "Total time (in seconds) to load dictionary: " << dictLoadTime << endl;
+
+  return runDaemon(argv[3], dictionary, workers);
 }
 
-// Spell-check the input file and write results to the output file
-void spellCheck(const string &inputFile, const string &outputFile, hashTable &dictionary)
+// Load the dictionary once and check every document named by a manifest or found in a directory
+int batchMode(int argc, char *argv[])
 {
-  ifstream inputStream(inputFile);
-  ofstream outputStream(outputFile);
+  if (argc < 5)
+  {
+    cerr << "Usage: " << argv[0] << " --batch <dictionary> <manifest | directory> <output directory> [workers]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  int workers = (argc > 5) ? atoi(argv[5]) : static_cast<int>(thread::hardware_concurrency());
 
+  vector<batchJob> jobs;
+  bool listed = filesystem::is_directory(argv[3]) ? jobsFromDirectory(argv[3], argv[4], jobs)
+                                                   : jobsFromManifest(argv[3], argv[4], jobs);
+  if (!listed)
+  {
+    return EXIT_FAILURE;
+  }
+
+  auto startTime = chrono::steady_clock::now();
+  hashTable dictionary = loadDictionary(argv[2]);
+  auto loadedTime = chrono::steady_clock::now();
+  int failures = runBatch(jobs, dictionary, workers);
+  auto endTime = chrono::steady_clock::now();
+
+  double dictLoadTime = chrono::duration<double>(loadedTime - startTime).count();
+  double checkTime = chrono::duration<double>(endTime - loadedTime).count();
+  cout << "Total time (in seconds) to load dictionary: " << dictLoadTime << endl;
+  cout << "Total time (in seconds) to check " << jobs.size() << " documents: " << checkTime << endl;
+  if (failures > 0)
+  {
+    cerr << failures << " of " << jobs.size() << " documents could not be checked" << endl;
+    return EXIT_FAILURE;
+  }
+  return 0;
+}
+
+// Re-check a document, reusing the results saved by the previous run for unchanged lines
+int incrementalMode(int argc, char *argv[])
+{
+  if (argc < 5)
+  {
+    cerr << "Usage: " << argv[0] << " --incremental <dictionary> <input file> <output file> [state file]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  string dictFile = argv[2];
+  string stateFile = (argc > 5) ? argv[5] : string(argv[4]) + ".state";
+
+  // Saved results are only valid for the exact dictionary they were computed with
+  struct stat info;
+  if (stat(dictFile.c_str(), &info) != 0)
+  {
+    cerr << "Error: Could not open dictionary file: " << dictFile << endl;
+    return EXIT_FAILURE;
+  }
+  string dictionaryTag = dictFile + ":" + to_string(info.st_size) + ":" + to_string(info.st_mtime);
+
+  ifstream inputStream(argv[3]);
   if (!inputStream.is_open())
   {
-    cerr << "Error: Could not open input file: " << inputFile << endl;
-    exit(EXIT_FAILURE);
+    cerr << "Error: Could not open input file: " << argv[3] << endl;
+    return EXIT_FAILURE;
   }
+  ofstream outputStream(argv[4]);
   if (!outputStream.is_open())
   {
-    cerr << "Error: Could not open output file: " << outputFile << endl;
-    exit(EXIT_FAILURE);
+    cerr << "Error: Could not open output file: " << argv[4] << endl;
+    return EXIT_FAILURE;
   }
 
-  string line;
-  int lineNumber = 1;
+  auto startTime = chrono::steady_clock::now();
+  hashTable dictionary = loadDictionary(dictFile);
+  auto loadedTime = chrono::steady_clock::now();
+
+  incrementalChecker checker(dictionary, dictionaryTag);
+  checker.load(stateFile);
+  int rechecked = checker.check(inputStream, outputStream);
+  auto endTime = chrono::steady_clock::now();
 
-  // Process each line in the input file
-  while (getline(inputStream, line))
+  if (!checker.save(stateFile))
   {
-    size_t i = 0;
-    size_t len = line.length();
-
-    while (i < len)
-    {
-      // Skip non-valid characters (word separators)
-      while (i < len && !(
-                            (line[i] >= 'A' && line[i] <= 'Z') ||
-                            (line[i] >= 'a' && line[i] <= 'z') ||
-                            (line[i] >= '0' && line[i] <= '9') ||
-                            line[i] == '-' || line[i] == '\''))
-      {
-        i++;
-      }
-
-      // Start of a word
-      if (i >= len)
-        break;
-
-      size_t wordStart = i;
-      size_t wordLength = 0;
-      bool hasDigit = false;
-      char wordBuffer[21]; // 20 characters max + null terminator
-
-      // Collect valid word characters
-      while (i < len && ((line[i] >= 'A' && line[i] <= 'Z') ||
-                         (line[i] >= 'a' && line[i] <= 'z') ||
-                         (line[i] >= '0' && line[i] <= '9') ||
-                         line[i] == '-' || line[i] == '\''))
-      {
-        char c = line[i];
-
-        // Check for digits
-        if (c >= '0' && c <= '9')
-        {
-          hasDigit = true;
-        }
-
-        // Convert uppercase letters to lowercase
-        if (c >= 'A' && c <= 'Z')
-        {
-          c = c + ('a' - 'A'); // Convert to lowercase
-        }
-
-        // Add character to word buffer if within length limit
-        if (wordLength < 20)
-        {
-          wordBuffer[wordLength++] = c;
-        }
-
-        i++;
-      }
-
-      size_t totalWordLength = i - wordStart;
-
-      // Process the word
-      if (totalWordLength > 20)
-      {
-        outputStream << "Long word at line " << lineNumber << ", starts: ";
-        outputStream.write(wordBuffer, 20);
-        outputStream << endl;
-      }
-      else if (!hasDigit)
-      {
-        wordBuffer[wordLength] = '\0'; // Null-terminate the word
-
-        if (!dictionary.contains(string(wordBuffer)))
-        {
-          outputStream << "Unknown word at line " << lineNumber << ": " << wordBuffer << endl;
-        }
-      }
-    }
-
-    lineNumber++;
+    cerr << "Warning: Could not save state file: " << stateFile << endl;
   }
 
-  inputStream.close();
-  outputStream.close();
+  double dictLoadTime = chrono::duration<double>(loadedTime - startTime).count();
+  double checkTime = chrono::duration<double>(endTime - loadedTime).count();
+  cout << "Total time (in seconds) to load dictionary: " << dictLoadTime << endl;
+  cout << "Total time (in seconds) to check document: " << checkTime << endl;
+  cout << "Lines re-checked: " << rechecked << " of " << checker.lineCount() << endl;
+  return 0;
 }
 
-int main()
+int main(int argc, char *argv[])
 {
+  if (argc > 1 && string(argv[1]) == "--daemon")
+  {
+    return daemonMode(argc, argv);
+  }
+  if (argc > 1 && string(argv[1]) == "--batch")
+  {
+    return batchMode(argc, argv);
+  }
+  if (argc > 1 && string(argv[1]) == "--incremental")
+  {
+    return incrementalMode(argc, argv);
+  }
+
   string dictFile, inputFile, outputFile;
 
   // Prompt user for input/output files and dictionary
@@ -188,18 +184,18 @@ int main()
   cout << "Enter name of output file: ";
   cin >> outputFile;
 
-  // Measure time to load dictionary
-  clock_t startTime = clock();
+  // Measure time to load dictionary (wall-clock time, since loading runs on several threads)
+  auto startTime = chrono::steady_clock::now();
   hashTable dictionary = loadDictionary(dictFile);
-  clock_t endTime = clock();
-  double dictLoadTime = double(endTime - startTime) / CLOCKS_PER_SEC;
+  auto endTime = chrono::steady_clock::now();
+  double dictLoadTime = chrono::duration<double>(endTime - startTime).count();
   cout << "Total time (in seconds) to load dictionary: " << dictLoadTime << endl;
 
   // Measure time to check the document
-  startTime = clock();
+  startTime = chrono::steady_clock::now();
   spellCheck(inputFile, outputFile, dictionary);
-  endTime = clock();
-  double spellCheckTime = double(endTime - startTime) / CLOCKS_PER_SEC;
+  endTime = chrono::steady_clock::now();
+  double spellCheckTime = chrono::duration<double>(endTime - startTime).count();
   cout << "Total time (in seconds) to check document: " << spellCheckTime << endl;
 
   return 0;
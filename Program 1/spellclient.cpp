@@ -0,0 +1,70 @@
+/* Name: Talha Akhlaq
+Description: This program sends a document to a running spell-check daemon and writes the report it
+returns, either to an output file or to standard output.
+Usage: spellclient <socket> [input file] [output file]
+*/
+
+#include "daemon.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    cerr << "Usage: " << argv[0] << " <socket> [input file] [output file]" << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Read the whole document from the input file, or from standard input when none is given
+  ostringstream document;
+  if (argc > 2 && string(argv[2]) != "-")
+  {
+    ifstream inputStream(argv[2], ios::binary);
+    if (!inputStream.is_open())
+    {
+      cerr << "Error: Could not open input file: " << argv[2] << endl;
+      return EXIT_FAILURE;
+    }
+    document << inputStream.rdbuf();
+  }
+  else
+  {
+    document << cin.rdbuf();
+  }
+
+  string report;
+  int result = checkRemote(argv[1], document.str(), report);
+  if (result == 1)
+  {
+    cerr << "Error: Could not connect to daemon at " << argv[1] << endl;
+    return EXIT_FAILURE;
+  }
+  if (result == 2)
+  {
+    cerr << "Error: Request to daemon failed" << endl;
+    return EXIT_FAILURE;
+  }
+
+  if (argc > 3)
+  {
+    ofstream outputStream(argv[3], ios::binary);
+    if (!outputStream.is_open())
+    {
+      cerr << "Error: Could not open output file: " << argv[3] << endl;
+      return EXIT_FAILURE;
+    }
+    outputStream << report;
+  }
+  else
+  {
+    cout << report;
+  }
+
+  return 0;
+}
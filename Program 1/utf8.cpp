@@ -0,0 +1,318 @@
+/* Name: Talha Akhlaq
+Description: This file implements the UTF-8 helpers used by the spell checker: a SIMD test for pure-ASCII
+text, strict decoding and encoding, and classification and case folding of Latin, Greek and Cyrillic letters.
+*/
+
+#include "utf8.h"
+#include <string>
+#include <cstring>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+using namespace std;
+
+// Any byte with its high bit set makes the text non-ASCII
+bool isAscii(const char *text, size_t len)
+{
+  size_t i = 0;
+
+#if defined(__AVX2__)
+  for (; i + 32 <= len; i += 32)
+  {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(text + i));
+    if (_mm256_movemask_epi8(v) != 0)
+    {
+      return false;
+    }
+  }
+#elif defined(__SSE2__)
+  for (; i + 32 <= len; i += 32)
+  {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text + i + 16));
+    if (_mm_movemask_epi8(_mm_or_si128(a, b)) != 0)
+    {
+      return false;
+    }
+  }
+#endif
+
+  // Remaining bytes, a word at a time where possible
+  for (; i + 8 <= len; i += 8)
+  {
+    uint64_t word;
+    memcpy(&word, text + i, sizeof(word));
+    if (word & 0x8080808080808080ull)
+    {
+      return false;
+    }
+  }
+  for (; i < len; ++i)
+  {
+    if (static_cast<unsigned char>(text[i]) & 0x80)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Strict decoder: rejects truncated, overlong and surrogate sequences
+bool decodeUtf8(const char *text, size_t len, size_t &pos, uint32_t &cp)
+{
+  unsigned char lead = text[pos];
+  int extra;
+  uint32_t minimum;
+
+  if (lead < 0x80)
+  {
+    cp = lead;
+    pos++;
+    return true;
+  }
+  else if ((lead & 0xE0) == 0xC0)
+  {
+    cp = lead & 0x1F;
+    extra = 1;
+    minimum = 0x80;
+  }
+  else if ((lead & 0xF0) == 0xE0)
+  {
+    cp = lead & 0x0F;
+    extra = 2;
+    minimum = 0x800;
+  }
+  else if ((lead & 0xF8) == 0xF0)
+  {
+    cp = lead & 0x07;
+    extra = 3;
+    minimum = 0x10000;
+  }
+  else
+  {
+    pos++;
+    return false;
+  }
+
+  if (pos + extra >= len)
+  {
+    pos++;
+    return false; // Sequence cut short by the end of the text
+  }
+
+  for (int k = 1; k <= extra; ++k)
+  {
+    unsigned char next = text[pos + k];
+    if ((next & 0xC0) != 0x80)
+    {
+      pos++;
+      return false;
+    }
+    cp = (cp << 6) | (next & 0x3F);
+  }
+
+  if (cp < minimum || cp > 0x10FFFF || (cp >= 0xD800 && cp <= 0xDFFF))
+  {
+    pos++;
+    return false;
+  }
+
+  pos += extra + 1;
+  return true;
+}
+
+// Encode a code point as one to four bytes
+void appendUtf8(string &out, uint32_t cp)
+{
+  if (cp < 0x80)
+  {
+    out += static_cast<char>(cp);
+  }
+  else if (cp < 0x800)
+  {
+    out += static_cast<char>(0xC0 | (cp >> 6));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  else if (cp < 0x10000)
+  {
+    out += static_cast<char>(0xE0 | (cp >> 12));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+  else
+  {
+    out += static_cast<char>(0xF0 | (cp >> 18));
+    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (cp & 0x3F));
+  }
+}
+
+// Letters of the Latin, Greek and Cyrillic blocks, plus combining accents
+bool isWordCodePoint(uint32_t cp)
+{
+  return (cp >= 0x00C0 && cp <= 0x02AF && cp != 0x00D7 && cp != 0x00F7) || // Latin-1 letters, Latin Extended-A/B, IPA
+         (cp >= 0x0300 && cp <= 0x036F) ||                                 // Combining diacritical marks
+         (cp >= 0x037B && cp <= 0x037D) ||                                 // Greek reversed lunate sigmas
+         cp == 0x0386 || (cp >= 0x0388 && cp <= 0x03FF) ||                 // Greek
+         (cp >= 0x0400 && cp <= 0x0481) || (cp >= 0x048A && cp <= 0x04FF) || // Cyrillic
+         (cp >= 0x1E00 && cp <= 0x1EFF);                                   // Latin Extended Additional
+}
+
+// Uppercase letters of Latin Extended-B, Greek and Cyrillic whose lowercase form is not the next code point
+// in order; U+023A and U+023E stay as they are, since their lowercase forms are outside the accepted letters
+static const uint32_t irregularUpper[][2] = {
+    {0x0181, 0x0253}, {0x0186, 0x0254}, {0x0189, 0x0256}, {0x018A, 0x0257}, {0x018E, 0x01DD}, {0x018F, 0x0259},
+    {0x0190, 0x025B}, {0x0193, 0x0260}, {0x0194, 0x0263}, {0x0196, 0x0269}, {0x0197, 0x0268}, {0x019C, 0x026F},
+    {0x019D, 0x0272}, {0x019F, 0x0275}, {0x01A6, 0x0280}, {0x01A9, 0x0283}, {0x01AE, 0x0288}, {0x01B1, 0x028A},
+    {0x01B2, 0x028B}, {0x01B7, 0x0292}, {0x01C4, 0x01C6}, {0x01C7, 0x01C9}, {0x01CA, 0x01CC}, {0x01F1, 0x01F3},
+    {0x01F6, 0x0195}, {0x01F7, 0x01BF}, {0x0220, 0x019E}, {0x023D, 0x019A}, {0x0243, 0x0180}, {0x0244, 0x0289},
+    {0x0245, 0x028C}, {0x03CF, 0x03D7}, {0x03F4, 0x03B8}, {0x03F9, 0x03F2}, {0x03FD, 0x037B}, {0x03FE, 0x037C},
+    {0x03FF, 0x037D}, {0x04C0, 0x04CF}, {0x1E9E, 0x00DF}};
+
+// Latin Extended-B and the Greek and Cyrillic additions, where case pairs are mostly adjacent
+static uint32_t foldExtended(uint32_t cp)
+{
+  for (const auto &pair : irregularUpper)
+  {
+    if (pair[0] == cp)
+    {
+      return pair[1];
+    }
+  }
+
+  // Title-case digraphs (Dž, Lj, Nj, Dz) fold like their uppercase forms
+  if (cp == 0x01C5 || cp == 0x01C8 || cp == 0x01CB || cp == 0x01F2)
+  {
+    return cp + 1;
+  }
+
+  // Runs where the uppercase letter is the odd code point of each pair
+  if ((cp >= 0x01CD && cp <= 0x01DB) || (cp >= 0x04C1 && cp <= 0x04CD))
+  {
+    return cp % 2 == 1 ? cp + 1 : cp;
+  }
+
+  // Runs where it is the even one
+  if ((cp >= 0x0182 && cp <= 0x0185) || (cp >= 0x01A0 && cp <= 0x01A5) || (cp >= 0x01DE && cp <= 0x01EF) ||
+      (cp >= 0x01F4 && cp <= 0x01F5) || (cp >= 0x01F8 && cp <= 0x021F) || (cp >= 0x0222 && cp <= 0x0233) ||
+      (cp >= 0x0246 && cp <= 0x024F) || (cp >= 0x03D8 && cp <= 0x03EF))
+  {
+    return cp % 2 == 0 ? cp + 1 : cp;
+  }
+
+  // Pairs on their own
+  if (cp == 0x0187 || cp == 0x018B || cp == 0x0191 || cp == 0x0198 || cp == 0x01A7 || cp == 0x01AC ||
+      cp == 0x01AF || cp == 0x01B3 || cp == 0x01B5 || cp == 0x01B8 || cp == 0x01BC || cp == 0x023B ||
+      cp == 0x0241 || cp == 0x03F7 || cp == 0x03FA)
+  {
+    return cp + 1;
+  }
+  return cp;
+}
+
+// Simple one-to-one lowercase mapping for the letters accepted above
+uint32_t foldCodePoint(uint32_t cp)
+{
+  if (cp >= 0x00C0 && cp <= 0x00DE && cp != 0x00D7)
+  {
+    return cp + 0x20;
+  }
+  if (cp >= 0x0100 && cp <= 0x017F)
+  {
+    // Upper and lower case alternate; the parity of the uppercase form flips twice
+    if (((cp <= 0x0137 || (cp >= 0x014A && cp <= 0x0177)) && cp % 2 == 0 && cp != 0x0130) ||
+        (((cp >= 0x0139 && cp <= 0x0148) || (cp >= 0x0179 && cp <= 0x017E)) && cp % 2 == 1))
+    {
+      return cp + 1;
+    }
+    return cp == 0x0178 ? 0x00FF : cp;
+  }
+  if (cp >= 0x0386 && cp <= 0x03AB)
+  {
+    if (cp == 0x0386)
+    {
+      return 0x03AC;
+    }
+    if (cp >= 0x0388 && cp <= 0x038A)
+    {
+      return cp + 0x25;
+    }
+    if (cp == 0x038C)
+    {
+      return 0x03CC;
+    }
+    if (cp == 0x038E || cp == 0x038F)
+    {
+      return cp + 0x3F;
+    }
+    if (cp >= 0x0391 && cp != 0x03A2)
+    {
+      return cp + 0x20;
+    }
+    return cp;
+  }
+  if (cp >= 0x0400 && cp <= 0x040F)
+  {
+    return cp + 0x50;
+  }
+  if (cp >= 0x0410 && cp <= 0x042F)
+  {
+    return cp + 0x20;
+  }
+  if (((cp >= 0x0460 && cp <= 0x0481) || (cp >= 0x048A && cp <= 0x04BF) || (cp >= 0x04D0 && cp <= 0x04FF) ||
+       (cp >= 0x1E00 && cp <= 0x1E95) || (cp >= 0x1EA0 && cp <= 0x1EFF)) &&
+      cp % 2 == 0)
+  {
+    return cp + 1;
+  }
+  if ((cp >= 0x0180 && cp <= 0x024F) || (cp >= 0x03CF && cp <= 0x03FF) || (cp >= 0x04C0 && cp <= 0x04CE) ||
+      cp == 0x1E9E)
+  {
+    return foldExtended(cp);
+  }
+  return cp;
+}
+
+// Apply the dictionary's character rules to a word that may contain UTF-8
+bool foldUtf8Word(const char *text, size_t len, size_t maxLength, string &out)
+{
+  out.clear();
+  size_t pos = 0;
+  size_t characters = 0;
+  while (pos < len)
+  {
+    uint32_t cp;
+    if (!decodeUtf8(text, len, pos, cp) || ++characters > maxLength)
+    {
+      return false;
+    }
+
+    if (cp < 0x80)
+    {
+      char c = static_cast<char>(cp);
+      if (c >= 'A' && c <= 'Z')
+      {
+        c += 'a' - 'A';
+      }
+      if (!((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '-' || c == '\''))
+      {
+        return false;
+      }
+      out += c;
+    }
+    else if (isWordCodePoint(cp))
+    {
+      appendUtf8(out, foldCodePoint(cp));
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
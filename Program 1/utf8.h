@@ -0,0 +1,31 @@
+#ifndef _UTF8_H
+#define _UTF8_H
+
+#include <string>
+#include <cstddef>
+#include <cstdint>
+
+// Check whether all len bytes are ASCII, 32 bytes per step with SIMD.
+bool isAscii(const char *text, size_t len);
+
+// Decode the code point starting at text[pos] and advance pos past it.
+// Returns false for a malformed, overlong or surrogate sequence;
+// pos then advances by one byte so the caller can skip it.
+bool decodeUtf8(const char *text, size_t len, size_t &pos, uint32_t &cp);
+
+// Append the UTF-8 encoding of cp to out.
+void appendUtf8(std::string &out, uint32_t cp);
+
+// Check whether a non-ASCII code point can be part of a word.
+// Covers the Latin, Greek and Cyrillic letters and combining accents.
+bool isWordCodePoint(uint32_t cp);
+
+// Lowercase a non-ASCII letter; other code points are returned unchanged.
+uint32_t foldCodePoint(uint32_t cp);
+
+// Validate and lowercase a dictionary word that contains UTF-8.
+// Returns false if it is malformed, has a character that cannot be part
+// of a word, or is longer than maxLength characters.
+bool foldUtf8Word(const char *text, size_t len, size_t maxLength, std::string &out);
+
+#endif //_UTF8_H
@@ -2,55 +2,291 @@
 #define _HEAP_H
 
 #include <vector>
+#include <utility>
 #include <string>
+#include <algorithm>
+#include <functional>
 #include "hash.h"
+#include "indexHeap.h"
 
+// One item for building a heap in a batch
+template <typename Key = int>
+struct heapItem
+{
+  std::string id; // Item id
+  Key key;        // Item key
+  void *pData;    // Pointer to item's associated data
+};
+
+// A d-ary min-heap of items identified by string ids; arity is the number
+// of children per node (2, 4 or 8). Each id is mapped once to an integer
+// handle, and the ordering itself is an indexHeap over those handles,
+// so percolation never touches the hash table.
+// The capacity is only a starting size: the heap doubles it when full.
+// Key and Compare are as for indexHeap: any key type Compare orders, with
+// Compare inlined, e.g. heap<int64_t> or heap<std::tuple<int, int>, std::less<>, 4>.
+// The member definitions follow the class, since they depend on Key and Compare.
+template <typename Key = int, typename Compare = std::less<Key>, int arity = 2>
 class heap
 {
 public:
-  // Constructor: sets capacity of heap
-  heap(int capacity);
+  // Constructor: sets initial capacity of heap
+  heap(int capacity, const Compare &compare = Compare());
+
+  // Constructor: holds the given items, heap-ordered in linear time
+  // Items whose id repeats an earlier item's are left out
+  heap(const std::vector<heapItem<Key>> &items, const Compare &compare = Compare());
 
   /// Inserts a node with key, optional data pointer, and id
-  // Returns 0 on success, 1 if heap is full, 2 if id already exists, 3 if hash table insert fails
-  int insert(const std::string &id, int key, void *pv = nullptr);
+  // Returns 0 on success, 2 if id already exists, 3 if hash table insert fails
+  int insert(const std::string &id, const Key &key, void *pv = nullptr);
 
   /// Updates key of node by id
   // Returns 0 on success, 1 if id not found
-  int setKey(const std::string &id, int key);
+  int setKey(const std::string &id, const Key &key);
+
+  // Updates the keys of many ids at once by handing the batch to indexHeap::setKeys, which
+  // percolates each changed entry for a small batch or rebuilds the heap with one heapify for a large one
+  // Returns 0 on success, 1 if some id was not found (the others are still updated)
+  int setKeys(const std::vector<std::pair<std::string, Key>> &changes);
+
+  // Returns the number of items in the heap
+  int size() const { return order.size(); }
 
   // Deletes the node with the smallest key
   // Optionally writes id, key, and data of the deleted node
   // Returns 0 on success, 1 if heap is empty
-  int deleteMin(std::string *pId = nullptr, int *pKey = nullptr, void **ppData = nullptr);
+  int deleteMin(std::string *pId = nullptr, Key *pKey = nullptr, void **ppData = nullptr);
 
   // Removes node by id and optionally writes its key and data
   // Returns 0 on success, 1 if id not found
-  int remove(const std::string &id, int *pKey = nullptr, void **ppData = nullptr);
+  int remove(const std::string &id, Key *pKey = nullptr, void **ppData = nullptr);
 
 private:
-  // Defines a node in the heap
+  // Defines the id and data of the item holding one handle
   class node
   {
   public:
     std::string id; // Node id
-    int key;        // Node key
     void *pData;    // Pointer to node's associated data
   };
 
-  int capacity;           // Max heap size
-  int currentSize;        // Current number of elements
-  std::vector<node> data; // Binary heap storage
-  hashTable mapping;      // Hash table for id lookups
+  int capacity;                         // Current heap size limit, raised by grow
+  std::vector<node> data;               // data[handle] describes the item holding that handle
+  std::vector<int> freeHandles;         // Handles not currently in use
+  indexHeap<Key, Compare, arity> order; // Heap order over the handles in use
+  hashTable mapping;                    // Maps each id to its node in data
+
+  // Doubles the capacity, fixing up the id mapping if data moves
+  void grow();
 
-  // Moves node at posCur up the heap
-  void percolateUp(int posCur);
+  // Looks up the handle for an id; returns -1 if the id is not in the heap
+  int findHandle(const std::string &id);
 
-  // Moves node at posCur down the heap
-  void percolateDown(int posCur);
+  // Returns the handle of a node, i.e. its position in data
+  int getHandle(node *pn);
 
-  // Returns the position of the node in the heap array
-  int getPos(node *pn);
+  // Forgets the item holding a handle, optionally writing its id and data
+  void release(int handle, std::string *pId, void **ppData);
 };
 
-#endif
\ No newline at end of file
+// Constructor for initializing heap with a given capacity
+template <typename Key, typename Compare, int arity>
+heap<Key, Compare, arity>::heap(int capacity, const Compare &compare)
+    : capacity(capacity), data(capacity), order(capacity, compare)
+{
+  // Hand out handle 0 first
+  freeHandles.reserve(capacity);
+  for (int handle = capacity - 1; handle >= 0; --handle)
+  {
+    freeHandles.push_back(handle);
+  }
+  mapping = hashTable(capacity * 2); // Initialize hash table for quick lookups
+}
+
+// Constructor for building a heap from a batch of items at once
+template <typename Key, typename Compare, int arity>
+heap<Key, Compare, arity>::heap(const std::vector<heapItem<Key>> &items, const Compare &compare)
+    : capacity(items.size()), data(items.size()), order(0, compare)
+{
+  mapping = hashTable(capacity * 2);
+
+  // Each item takes the next handle unless its id was already seen
+  std::vector<Key> keys;
+  keys.reserve(items.size());
+  for (const heapItem<Key> &item : items)
+  {
+    int handle = keys.size();
+    HEAP_COUNT(hashCalls, 1);
+    if (mapping.insert(item.id, &data[handle]) != 0)
+    {
+      continue;
+    }
+    data[handle].id = item.id;
+    data[handle].pData = item.pData;
+    keys.push_back(item.key);
+  }
+
+  for (int handle = capacity - 1; handle >= static_cast<int>(keys.size()); --handle)
+  {
+    freeHandles.push_back(handle);
+  }
+  order = indexHeap<Key, Compare, arity>(keys, compare);
+  order.reserve(capacity);
+}
+
+// Insert a node into the heap with the specified ID and key
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::insert(const std::string &id, const Key &key, void *pv)
+{
+  HEAP_COUNT(hashCalls, 1);
+  if (mapping.contains(id))
+  {
+    return 2;
+  }
+
+  if (freeHandles.empty())
+  {
+    grow();
+  }
+
+  int handle = freeHandles.back();
+  HEAP_COUNT(hashCalls, 1);
+  if (mapping.insert(id, &data[handle]) != 0)
+  {
+    return 3; // Error code for hash table insertion failure
+  }
+  freeHandles.pop_back();
+
+  data[handle].id = id;
+  data[handle].pData = pv;
+  order.insert(handle, key);
+  return 0;
+}
+
+// Set the key of the node with the given ID and adjust the heap accordingly
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::setKey(const std::string &id, const Key &key)
+{
+  int handle = findHandle(id);
+  if (handle == -1)
+  {
+    return 1;
+  }
+  return order.setKey(handle, key);
+}
+
+// Look up every id, then hand the whole batch to the handle heap
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::setKeys(const std::vector<std::pair<std::string, Key>> &changes)
+{
+  int result = 0;
+  std::vector<std::pair<int, Key>> handleChanges;
+  handleChanges.reserve(changes.size());
+  for (const std::pair<std::string, Key> &change : changes)
+  {
+    int handle = findHandle(change.first);
+    if (handle == -1)
+    {
+      result = 1;
+      continue;
+    }
+    handleChanges.emplace_back(handle, change.second);
+  }
+  order.setKeys(handleChanges);
+  return result;
+}
+
+// Delete the node with the smallest key (the root of the heap) and return its details
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::deleteMin(std::string *pId, Key *pKey, void **ppData)
+{
+  int handle;
+  if (order.deleteMin(&handle, pKey) != 0)
+  {
+    return 1;
+  }
+  release(handle, pId, ppData);
+  return 0;
+}
+
+// Remove the node with the specified ID from the heap and return its details
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::remove(const std::string &id, Key *pKey, void **ppData)
+{
+  int handle = findHandle(id);
+  if (handle == -1)
+  {
+    return 1;
+  }
+  order.remove(handle, pKey);
+  release(handle, nullptr, ppData);
+  return 0;
+}
+
+// Double the capacity, making the new handles available
+template <typename Key, typename Compare, int arity>
+void heap<Key, Compare, arity>::grow()
+{
+  int newCapacity = std::max(1, capacity * 2);
+  node *oldData = data.data();
+  data.resize(newCapacity);
+
+  // The mapping points into data, so a reallocation leaves it pointing at the old array
+  if (data.data() != oldData)
+  {
+    for (int handle = 0; handle < capacity; ++handle)
+    {
+      if (order.contains(handle))
+      {
+        HEAP_COUNT(hashCalls, 1);
+        mapping.setPointer(data[handle].id, &data[handle]);
+      }
+    }
+  }
+
+  // Hand out the lowest new handle first
+  for (int handle = newCapacity - 1; handle >= capacity; --handle)
+  {
+    freeHandles.push_back(handle);
+  }
+  order.reserve(newCapacity);
+  capacity = newCapacity;
+}
+
+// Find the handle of an ID through the hash table
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::findHandle(const std::string &id)
+{
+  bool found = false;
+  HEAP_COUNT(hashCalls, 1);
+  node *pn = static_cast<node *>(mapping.getPointer(id, &found));
+  return found ? getHandle(pn) : -1;
+}
+
+// Get the handle of a node from its position in the data array
+template <typename Key, typename Compare, int arity>
+int heap<Key, Compare, arity>::getHandle(node *pn)
+{
+  return pn - data.data();
+}
+
+// Drop the ID mapping for a handle and make the handle available again
+template <typename Key, typename Compare, int arity>
+void heap<Key, Compare, arity>::release(int handle, std::string *pId, void **ppData)
+{
+  node &n = data[handle];
+  if (ppData != nullptr)
+  {
+    *ppData = n.pData;
+  }
+  HEAP_COUNT(hashCalls, 1);
+  mapping.remove(n.id);
+  if (pId != nullptr)
+  {
+    *pId = std::move(n.id);
+  }
+  freeHandles.push_back(handle);
+}
+
+#endif
@@ -0,0 +1,438 @@
+//
+// This program times the heap with 2, 4 and 8 children per node
+// on a few operation mixes, to show which arity suits each one,
+// through both the string-id interface and the integer-handle one,
+// with keys changed one at a time and in batches,
+// with int, int64, double and tuple keys,
+// and times the pairing heap on the same mixes.
+// Last, it picks the 100 smallest keys of a stream of 50 * n keys
+// with a full heap and with the bounded top-k heap.
+// Usage: heapBench.exe [number of items]
+//
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include <cstdint>
+#include <tuple>
+#include <functional>
+#include <algorithm>
+
+#include "heap.h"
+#include "indexHeap.h"
+#include "pairingHeap.h"
+#include "topK.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// Item i is known as ids[i] to the string-id heap and as handle i to indexHeap
+vector<string> ids;
+
+// Workloads make int keys; these turn them into each key type and back without changing their order
+template <typename Key>
+Key toKey(int key) { return static_cast<Key>(key); }
+template <>
+tuple<int, int> toKey(int key) { return tuple<int, int>(key / 1000, key % 1000); }
+template <typename Key>
+int fromKey(const Key &key) { return static_cast<int>(key); }
+template <>
+int fromKey(const tuple<int, int> &key) { return get<0>(key) * 1000 + get<1>(key); }
+
+template <typename Key, typename Compare, int arity>
+void addItem(heap<Key, Compare, arity> &h, int i, int key) { h.insert(ids[i], toKey<Key>(key)); }
+template <typename Key, typename Compare, int arity>
+void changeKey(heap<Key, Compare, arity> &h, int i, int key) { h.setKey(ids[i], toKey<Key>(key)); }
+template <typename Key, typename Compare, int arity>
+void changeKeys(heap<Key, Compare, arity> &h, const vector<pair<int, int>> &changes)
+{
+  vector<pair<string, Key>> batch;
+  batch.reserve(changes.size());
+  for (const pair<int, int> &change : changes)
+  {
+    batch.emplace_back(ids[change.first], toKey<Key>(change.second));
+  }
+  h.setKeys(batch);
+}
+template <typename Key, typename Compare, int arity>
+bool popMin(heap<Key, Compare, arity> &h, int &key)
+{
+  Key k;
+  if (h.deleteMin(nullptr, &k) != 0)
+  {
+    return false;
+  }
+  key = fromKey(k);
+  return true;
+}
+
+template <typename Key, typename Compare, int arity>
+void addItem(indexHeap<Key, Compare, arity> &h, int i, int key) { h.insert(i, toKey<Key>(key)); }
+template <typename Key, typename Compare, int arity>
+void changeKey(indexHeap<Key, Compare, arity> &h, int i, int key) { h.setKey(i, toKey<Key>(key)); }
+template <typename Key, typename Compare, int arity>
+void changeKeys(indexHeap<Key, Compare, arity> &h, const vector<pair<int, int>> &changes)
+{
+  vector<pair<int, Key>> batch;
+  batch.reserve(changes.size());
+  for (const pair<int, int> &change : changes)
+  {
+    batch.emplace_back(change.first, toKey<Key>(change.second));
+  }
+  h.setKeys(batch);
+}
+template <typename Key, typename Compare, int arity>
+bool popMin(indexHeap<Key, Compare, arity> &h, int &key)
+{
+  Key k;
+  if (h.deleteMin(nullptr, &k) != 0)
+  {
+    return false;
+  }
+  key = fromKey(k);
+  return true;
+}
+
+// Heap families by arity, one per row of the table
+template <int arity>
+using intHeap = heap<int, less<int>, arity>;
+template <int arity>
+using intIndexHeap = indexHeap<int, less<int>, arity>;
+template <int arity>
+using int64Heap = heap<int64_t, less<int64_t>, arity>;
+template <int arity>
+using doubleHeap = heap<double, less<double>, arity>;
+template <int arity>
+using tupleHeap = heap<tuple<int, int>, less<tuple<int, int>>, arity>;
+
+void addItem(pairingHeap &h, int i, int key) { h.insert(ids[i], key); }
+void changeKey(pairingHeap &h, int i, int key) { h.setKey(ids[i], key); }
+bool popMin(pairingHeap &h, int &key) { return h.deleteMin(nullptr, &key) == 0; }
+
+// Drain the heap, checking keys come out in order; returns false if they do not
+template <typename Heap>
+bool drain(Heap &h)
+{
+  int key;
+  int previous = 0;
+  bool first = true;
+  bool ordered = true;
+  while (popMin(h, key))
+  {
+    if (!first && key < previous)
+    {
+      ordered = false;
+    }
+    previous = key;
+    first = false;
+  }
+  return ordered;
+}
+
+// Insert every item with a random key, then deleteMin them all
+template <typename Heap>
+bool insertThenDrain(int n, mt19937 &rng)
+{
+  Heap h(n);
+  for (int i = 0; i < n; ++i)
+  {
+    addItem(h, i, rng() % 1000000000);
+  }
+  return drain(h);
+}
+
+// Same, but starting from a capacity of 1 so the heap grows as it fills
+template <typename Heap>
+bool growThenDrain(int n, mt19937 &rng)
+{
+  Heap h(1);
+  for (int i = 0; i < n; ++i)
+  {
+    addItem(h, i, rng() % 1000000000);
+  }
+  return drain(h);
+}
+
+// Build a heap from every item at once, with Floyd's heapify
+template <typename Key, typename Compare, int arity>
+heap<Key, Compare, arity> buildHeap(heap<Key, Compare, arity> *, const vector<int> &keys)
+{
+  vector<heapItem<Key>> items(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+  {
+    items[i] = {ids[i], toKey<Key>(keys[i]), nullptr};
+  }
+  return heap<Key, Compare, arity>(items);
+}
+template <typename Key, typename Compare, int arity>
+indexHeap<Key, Compare, arity> buildHeap(indexHeap<Key, Compare, arity> *, const vector<int> &keys)
+{
+  return indexHeap<Key, Compare, arity>(vector<Key>(keys.begin(), keys.end()));
+}
+
+// Build the heap from all the random keys in one batch, then deleteMin them all
+template <typename Heap>
+bool batchThenDrain(int n, mt19937 &rng)
+{
+  vector<int> keys(n);
+  for (int i = 0; i < n; ++i)
+  {
+    keys[i] = rng() % 1000000000;
+  }
+  Heap h = buildHeap(static_cast<Heap *>(nullptr), keys);
+  return drain(h);
+}
+
+// Dijkstra-like: each deleteMin is followed by a few decrease-keys of
+// random items to values at or above the key just removed
+template <typename Heap>
+bool decreaseKeyMix(int n, mt19937 &rng)
+{
+  Heap h(n);
+  for (int i = 0; i < n; ++i)
+  {
+    addItem(h, i, 1000000000 - static_cast<int>(rng() % 1000));
+  }
+
+  int key;
+  int previous = 0;
+  bool ordered = true;
+  while (popMin(h, key))
+  {
+    if (key < previous)
+    {
+      ordered = false;
+    }
+    previous = key;
+    for (int k = 0; k < 3; ++k)
+    {
+      changeKey(h, rng() % n, key + static_cast<int>(rng() % 100000)); // Ignored for items already removed
+    }
+  }
+  return ordered;
+}
+
+// Many increases and decreases of random keys, then drain
+template <typename Heap>
+bool setKeyHeavy(int n, mt19937 &rng)
+{
+  Heap h(n);
+  for (int i = 0; i < n; ++i)
+  {
+    addItem(h, i, rng() % 1000000000);
+  }
+  for (int i = 0; i < n * 4; ++i)
+  {
+    changeKey(h, rng() % n, rng() % 1000000000);
+  }
+  return drain(h);
+}
+
+// Number of smallest keys picked from the stream
+const int topCount = 100;
+
+// Top-k baseline: heapify the whole stream, then take k minimums
+bool topWithFullHeap(const vector<int> &stream, vector<int> &top)
+{
+  indexHeap<int, less<int>, 4> h(stream, less<int>());
+  top.resize(topCount);
+  for (int &key : top)
+  {
+    h.deleteMin(nullptr, &key);
+  }
+  return true;
+}
+
+// Top-k with one offer per key
+bool topWithOffer(const vector<int> &stream, vector<int> &top)
+{
+  topK<int> selection(topCount);
+  for (int key : stream)
+  {
+    selection.offer(key);
+  }
+  selection.extract(top);
+  return true;
+}
+
+// Top-k with the whole stream offered at once, filtered 8 keys at a time
+bool topWithOfferMany(const vector<int> &stream, vector<int> &top)
+{
+  topK<int> selection(topCount);
+  selection.offerMany(stream.data(), stream.size());
+  selection.extract(top);
+  return true;
+}
+
+// Time one way of picking the top keys, in milliseconds, and check its answer
+double timeTop(bool (*pick)(const vector<int> &, vector<int> &), const vector<int> &stream, const vector<int> &expected, bool &ok)
+{
+  vector<int> top;
+  auto start = steady_clock::now();
+  pick(stream, top);
+  double ms = duration_cast<duration<double, milli>>(steady_clock::now() - start).count();
+  ok = ok && top == expected;
+  return ms;
+}
+
+// Change 2n random keys in batches of the given percent of the heap, either with one
+// setKey per change or with one setKeys per batch, then drain
+template <typename Heap, int percent, bool batched>
+bool keyBatches(int n, mt19937 &rng)
+{
+  Heap h(n);
+  for (int i = 0; i < n; ++i)
+  {
+    addItem(h, i, rng() % 1000000000);
+  }
+
+  int batchSize = max(1, n / 100 * percent);
+  vector<pair<int, int>> changes(batchSize);
+  for (int done = 0; done < n * 2; done += batchSize)
+  {
+    for (pair<int, int> &change : changes)
+    {
+      change = {static_cast<int>(rng() % n), static_cast<int>(rng() % 1000000000)};
+    }
+    if (batched)
+    {
+      changeKeys(h, changes);
+    }
+    else
+    {
+      for (const pair<int, int> &change : changes)
+      {
+        changeKey(h, change.first, change.second);
+      }
+    }
+  }
+  return drain(h);
+}
+
+// Time one workload, in milliseconds
+double timeWorkload(bool (*workload)(int, mt19937 &), int n, bool &ok)
+{
+  mt19937 rng(365); // Same sequence for every heap
+  auto start = steady_clock::now();
+  ok = workload(n, rng) && ok;
+  return duration_cast<duration<double, milli>>(steady_clock::now() - start).count();
+}
+
+// Print one row: a workload run on each arity of one heap family
+template <template <int> class Heap, template <typename> class Workload>
+void printRow(const string &name, int n, bool &ok)
+{
+  cout << left << setw(40) << name << right
+       << setw(12) << timeWorkload(Workload<Heap<2>>::run, n, ok)
+       << setw(12) << timeWorkload(Workload<Heap<4>>::run, n, ok)
+       << setw(12) << timeWorkload(Workload<Heap<8>>::run, n, ok) << "\n";
+}
+
+// Workloads wrapped so they can be passed as template template arguments
+template <typename Heap>
+struct insertDrainRun
+{
+  static bool run(int n, mt19937 &rng) { return insertThenDrain<Heap>(n, rng); }
+};
+template <typename Heap>
+struct growDrainRun
+{
+  static bool run(int n, mt19937 &rng) { return growThenDrain<Heap>(n, rng); }
+};
+template <typename Heap>
+struct batchDrainRun
+{
+  static bool run(int n, mt19937 &rng) { return batchThenDrain<Heap>(n, rng); }
+};
+template <typename Heap>
+struct decreaseKeyRun
+{
+  static bool run(int n, mt19937 &rng) { return decreaseKeyMix<Heap>(n, rng); }
+};
+template <typename Heap>
+struct setKeyHeavyRun
+{
+  static bool run(int n, mt19937 &rng) { return setKeyHeavy<Heap>(n, rng); }
+};
+template <int percent, bool batched>
+struct keyBatchRun
+{
+  template <typename Heap>
+  struct of
+  {
+    static bool run(int n, mt19937 &rng) { return keyBatches<Heap, percent, batched>(n, rng); }
+  };
+};
+
+int main(int argc, char *argv[])
+{
+  int n = (argc > 1) ? atoi(argv[1]) : 200000;
+  if (n < 1)
+  {
+    cerr << "Error, the number of items must be positive!\n";
+    exit(1);
+  }
+
+  ids.resize(n);
+  for (int i = 0; i < n; ++i)
+  {
+    ids[i] = "item" + to_string(i);
+  }
+
+  bool ok = true;
+  cout << "Items: " << n << " (times in ms)\n";
+  cout << left << setw(40) << "Workload" << right << setw(12) << "arity 2" << setw(12) << "arity 4" << setw(12) << "arity 8" << "\n";
+  cout << fixed << setprecision(1);
+
+  printRow<intHeap, insertDrainRun>("insert + deleteMin (string ids)", n, ok);
+  printRow<intIndexHeap, insertDrainRun>("insert + deleteMin (handles)", n, ok);
+  printRow<intHeap, growDrainRun>("grow from 1 + deleteMin (string ids)", n, ok);
+  printRow<intIndexHeap, growDrainRun>("grow from 1 + deleteMin (handles)", n, ok);
+  printRow<intHeap, batchDrainRun>("heapify + deleteMin (string ids)", n, ok);
+  printRow<intIndexHeap, batchDrainRun>("heapify + deleteMin (handles)", n, ok);
+  printRow<intHeap, decreaseKeyRun>("deleteMin + setKey (string ids)", n, ok);
+  printRow<intIndexHeap, decreaseKeyRun>("deleteMin + setKey (handles)", n, ok);
+  printRow<intHeap, setKeyHeavyRun>("setKey heavy (string ids)", n, ok);
+  printRow<intIndexHeap, setKeyHeavyRun>("setKey heavy (handles)", n, ok);
+  printRow<intIndexHeap, keyBatchRun<1, false>::of>("1% batches, setKey each (handles)", n, ok);
+  printRow<intIndexHeap, keyBatchRun<1, true>::of>("1% batches, setKeys (handles)", n, ok);
+  printRow<intIndexHeap, keyBatchRun<25, false>::of>("25% batches, setKey each (handles)", n, ok);
+  printRow<intIndexHeap, keyBatchRun<25, true>::of>("25% batches, setKeys (handles)", n, ok);
+  printRow<intHeap, keyBatchRun<25, false>::of>("25% batches, setKey each (string ids)", n, ok);
+  printRow<intHeap, keyBatchRun<25, true>::of>("25% batches, setKeys (string ids)", n, ok);
+  printRow<int64Heap, decreaseKeyRun>("deleteMin + setKey (int64 keys)", n, ok);
+  printRow<doubleHeap, decreaseKeyRun>("deleteMin + setKey (double keys)", n, ok);
+  printRow<tupleHeap, decreaseKeyRun>("deleteMin + setKey (tuple keys)", n, ok);
+
+  cout << "\n" << left << setw(40) << "Workload" << right << setw(12) << "pairing" << "\n";
+  cout << left << setw(40) << "insert + deleteMin (string ids)" << right << setw(12) << timeWorkload(insertThenDrain<pairingHeap>, n, ok) << "\n";
+  cout << left << setw(40) << "deleteMin + setKey (string ids)" << right << setw(12) << timeWorkload(decreaseKeyMix<pairingHeap>, n, ok) << "\n";
+  cout << left << setw(40) << "setKey heavy (string ids)" << right << setw(12) << timeWorkload(setKeyHeavy<pairingHeap>, n, ok) << "\n";
+
+  // Every way must agree with a partial sort of the stream
+  vector<int> stream(static_cast<size_t>(n) * 50);
+  mt19937 rng(365);
+  for (int &key : stream)
+  {
+    key = rng() % 1000000000;
+  }
+  vector<int> expected(stream);
+  partial_sort(expected.begin(), expected.begin() + topCount, expected.end());
+  expected.resize(topCount);
+
+  cout << "\n" << left << setw(40) << "Smallest 100 of a stream" << right << setw(12) << "time" << "\n";
+  cout << left << setw(40) << "heapify + deleteMin (handles)" << right << setw(12) << timeTop(topWithFullHeap, stream, expected, ok) << "\n";
+  cout << left << setw(40) << "top-k offer" << right << setw(12) << timeTop(topWithOffer, stream, expected, ok) << "\n";
+  cout << left << setw(40) << "top-k offerMany" << right << setw(12) << timeTop(topWithOfferMany, stream, expected, ok) << "\n";
+
+  if (!ok)
+  {
+    cerr << "Error, keys came out of the heap out of order!\n";
+    exit(1);
+  }
+  return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef _HEAPSTATS_H
+#define _HEAPSTATS_H
+
+// Counters of the work done inside the heaps, for finding out where an
+// operation's time goes. They are only compiled in when HEAP_STATS is
+// defined (g++ -DHEAP_STATS); otherwise HEAP_COUNT expands to nothing,
+// so the normal build pays nothing for them.
+struct heapStats
+{
+  long long comparisons = 0; // Key comparisons, including each lane of an SSE2 child scan
+  long long moves = 0;       // Entries moved from one position to another, i.e. levels percolated
+  long long hashCalls = 0;   // Calls into the id hash table
+
+  void reset() { *this = heapStats(); }
+};
+
+#ifdef HEAP_STATS
+// One set of counters per thread, so threads sharing a heap type do not race on them
+inline thread_local heapStats heapCounters;
+#define HEAP_COUNT(counter, n) (heapCounters.counter += (n))
+#else
+#define HEAP_COUNT(counter, n) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,518 @@
+#ifndef _INDEXHEAP_H
+#define _INDEXHEAP_H
+
+#include <vector>
+#include <utility>
+#include <new>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include "heapStats.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Allocator that aligns storage to a cache line, so a group of
+// sibling keys in the heap never straddles two lines
+template <typename T>
+class cacheAlignedAllocator
+{
+public:
+  using value_type = T;
+  static constexpr std::size_t alignment = 64;
+
+  cacheAlignedAllocator() = default;
+  template <typename U>
+  cacheAlignedAllocator(const cacheAlignedAllocator<U> &) {}
+
+  T *allocate(std::size_t n)
+  {
+    return static_cast<T *>(::operator new(n * sizeof(T), std::align_val_t(alignment)));
+  }
+
+  void deallocate(T *p, std::size_t)
+  {
+    ::operator delete(p, std::align_val_t(alignment));
+  }
+
+  bool operator==(const cacheAlignedAllocator &) const { return true; }
+  bool operator!=(const cacheAlignedAllocator &) const { return false; }
+};
+
+// A d-ary min-heap of dense integer handles in [0, capacity); inserting a
+// handle past the end grows the arrays geometrically.
+// Each handle's position is tracked in a plain array, so percolation
+// only moves array entries and never hashes anything.
+// Keys may be any type Compare orders (int, int64_t, double, tuples, ...);
+// Compare is a function object called directly, so it is inlined.
+// arity is the number of children per node (2, 4 or 8); keys are kept in
+// their own cache-aligned array with each node's children contiguous.
+// The member definitions follow the class, since they depend on Key and Compare.
+template <typename Key = int, typename Compare = std::less<Key>, int arity = 2>
+class indexHeap
+{
+  static_assert(arity == 2 || arity == 4 || arity == 8, "heap arity must be 2, 4 or 8");
+
+public:
+  // Constructor: makes room for handles 0 .. capacity - 1
+  indexHeap(int capacity, const Compare &compare = Compare());
+
+  // Constructor: inserts handle i with key keys[i] for every i, in linear time
+  indexHeap(const std::vector<Key> &keys, const Compare &compare = Compare());
+
+  // Inserts a handle with the given key, growing the heap if the handle is past its capacity
+  // Returns 0 on success, 1 if the handle is negative, 2 if it is already in the heap
+  int insert(int handle, const Key &key);
+
+  // Updates the key of a handle in the heap
+  // Returns 0 on success, 1 if the handle is not in the heap
+  int setKey(int handle, const Key &key);
+
+  // Updates the keys of many handles at once: a small batch is repaired by percolating
+  // each changed entry, while a batch that is a large part of the heap has all its
+  // keys written first and the heap rebuilt once with Floyd's heapify
+  // Returns 0 on success, 1 if some handle is not in the heap (the others are still updated)
+  int setKeys(const std::vector<std::pair<int, Key>> &changes);
+
+  // Deletes the handle with the smallest key
+  // Optionally writes its handle and key
+  // Returns 0 on success, 1 if heap is empty
+  int deleteMin(int *pHandle = nullptr, Key *pKey = nullptr);
+
+  // Optionally writes the handle with the smallest key and its key, leaving it in the heap
+  // Returns 0 on success, 1 if heap is empty
+  int peekMin(int *pHandle = nullptr, Key *pKey = nullptr) const;
+
+  // Gives the handle with the smallest key a new key in place and moves it down,
+  // cheaper than a deleteMin followed by an insert; optionally writes that handle
+  // Returns 0 on success, 1 if heap is empty
+  int replaceMin(const Key &key, int *pHandle = nullptr);
+
+  // Removes a handle from the heap and optionally writes its key
+  // Returns 0 on success, 1 if the handle is not in the heap
+  int remove(int handle, Key *pKey = nullptr);
+
+  // Returns true if the handle is currently in the heap
+  bool contains(int handle) const;
+
+  // Returns the number of handles in the heap
+  int size() const { return currentSize; }
+
+  // Returns true if the heap holds no handles
+  bool empty() const { return currentSize == 0; }
+
+  // Returns the number of handles there is room for
+  int getCapacity() const { return capacity; }
+
+  // Makes room for handles 0 .. newCapacity - 1; never shrinks
+  void reserve(int newCapacity);
+
+private:
+  // Position of the root. Children of the node at pos are at
+  // firstChild(pos) .. firstChild(pos) + arity - 1, which always starts at a
+  // multiple of arity; for a binary heap this is the usual 1-based layout.
+  static constexpr int root = arity - 1;
+
+  // The SSE2 child scan compares ints with <, so it only serves the default int heap
+  static constexpr bool simdKeys = std::is_same<Key, int>::value && std::is_same<Compare, std::less<int>>::value;
+
+  int capacity;                                      // Number of handles
+  int currentSize;                                   // Current number of elements
+  Compare less;                                      // less(a, b) is true if a belongs above b
+  std::vector<Key, cacheAlignedAllocator<Key>> keys; // keys[pos] is the key of the handle at pos
+  std::vector<int> handles;                          // handles[pos] is the handle stored at pos
+  std::vector<int> position;                         // position[handle] is its pos, or -1 if absent
+
+  static int parent(int pos) { return (pos - root - 1) / arity + root; }
+  static int firstChild(int pos) { return arity * (pos - root) + root + 1; }
+  int lastPos() const { return root + currentSize - 1; }
+
+  // Compares two keys with less, counting the comparison when HEAP_STATS is defined
+  bool before(const Key &a, const Key &b) const
+  {
+    HEAP_COUNT(comparisons, 1);
+    return less(a, b);
+  }
+
+  // Returns the position of the smallest child, given the position of the first child
+  int minChild(int first) const;
+
+  // Moves the entry at posCur up the heap
+  void percolateUp(int posCur);
+
+  // Moves the entry at posCur down the heap
+  void percolateDown(int posCur);
+
+  // Restores the heap property everywhere with Floyd's heapify
+  void heapify();
+};
+
+namespace indexHeapDetail
+{
+#ifdef __SSE2__
+  // Lane-wise minimum of four ints (SSE2 has no _mm_min_epi32)
+  inline __m128i min4(__m128i a, __m128i b)
+  {
+    __m128i aLess = _mm_cmplt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(aLess, a), _mm_andnot_si128(aLess, b));
+  }
+
+  // Index of the smallest of n (4 or 8) keys starting at an aligned address;
+  // the first one wins ties, matching the scalar scan
+  inline int minIndex(const int *group, int n)
+  {
+    __m128i low = _mm_load_si128(reinterpret_cast<const __m128i *>(group));
+    __m128i high = (n == 8) ? _mm_load_si128(reinterpret_cast<const __m128i *>(group + 4)) : low;
+    __m128i m = min4(low, high);
+    m = min4(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(2, 3, 0, 1)));
+    m = min4(m, _mm_shuffle_epi32(m, _MM_SHUFFLE(1, 0, 3, 2))); // Minimum is now in every lane
+
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(low, m)));
+    if (n == 8)
+    {
+      mask |= _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(high, m))) << 4;
+    }
+    return __builtin_ctz(mask);
+  }
+#endif
+}
+
+// Constructor for initializing heap with a given number of handles
+template <typename Key, typename Compare, int arity>
+indexHeap<Key, Compare, arity>::indexHeap(int capacity, const Compare &compare)
+    : capacity(capacity), currentSize(0), less(compare),
+      keys(root + capacity), handles(root + capacity), position(capacity, -1)
+{
+}
+
+// Constructor that builds the heap from every handle's key at once
+template <typename Key, typename Compare, int arity>
+indexHeap<Key, Compare, arity>::indexHeap(const std::vector<Key> &initialKeys, const Compare &compare)
+    : indexHeap(static_cast<int>(initialKeys.size()), compare)
+{
+  currentSize = capacity;
+  for (int handle = 0; handle < capacity; ++handle)
+  {
+    keys[root + handle] = initialKeys[handle];
+    handles[root + handle] = handle;
+    position[handle] = root + handle;
+  }
+
+  heapify();
+}
+
+// Insert a handle with the specified key
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::insert(int handle, const Key &key)
+{
+  if (handle < 0)
+  {
+    return 1;
+  }
+  if (handle >= capacity)
+  {
+    reserve(std::max(handle + 1, capacity * 2));
+  }
+  if (position[handle] != -1)
+  {
+    return 2;
+  }
+
+  currentSize++;
+  int pos = lastPos();
+  keys[pos] = key;
+  handles[pos] = handle;
+  percolateUp(pos);
+  return 0;
+}
+
+// Set the key of a handle and adjust the heap accordingly
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::setKey(int handle, const Key &key)
+{
+  if (!contains(handle))
+  {
+    return 1;
+  }
+
+  int pos = position[handle];
+  bool increased = before(keys[pos], key);
+  keys[pos] = key;
+
+  // Perform percolation based on whether the key was increased or decreased
+  if (increased)
+  {
+    percolateDown(pos);
+  }
+  else
+  {
+    percolateUp(pos);
+  }
+  return 0;
+}
+
+// Set many keys, repairing the heap after each one or once at the end
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::setKeys(const std::vector<std::pair<int, Key>> &changes)
+{
+  // A changed entry usually percolates only a few levels, while heapifying visits
+  // every node with children; with random keys, heapifying wins from a batch of
+  // about a quarter of the number of those nodes (n / arity)
+  bool rebuild = 4LL * arity * static_cast<long long>(changes.size()) >= currentSize;
+
+  int result = 0;
+  if (!rebuild)
+  {
+    for (const std::pair<int, Key> &change : changes)
+    {
+      if (setKey(change.first, change.second) != 0)
+      {
+        result = 1;
+      }
+    }
+    return result;
+  }
+
+  for (const std::pair<int, Key> &change : changes)
+  {
+    if (!contains(change.first))
+    {
+      result = 1;
+      continue;
+    }
+    keys[position[change.first]] = change.second;
+  }
+  heapify();
+  return result;
+}
+
+// Delete the handle with the smallest key (the root of the heap)
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::deleteMin(int *pHandle, Key *pKey)
+{
+  if (currentSize == 0)
+  {
+    return 1;
+  }
+
+  if (pHandle != nullptr)
+  {
+    *pHandle = handles[root];
+  }
+  if (pKey != nullptr)
+  {
+    *pKey = keys[root];
+  }
+
+  position[handles[root]] = -1;
+
+  // Replace the root with the last element and decrease the heap size
+  int last = lastPos();
+  if (last != root)
+  {
+    HEAP_COUNT(moves, 1);
+    keys[root] = std::move(keys[last]);
+    handles[root] = handles[last];
+  }
+  currentSize--;
+
+  if (currentSize > 0)
+  {
+    percolateDown(root);
+  }
+  return 0;
+}
+
+// Look at the handle with the smallest key without removing it
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::peekMin(int *pHandle, Key *pKey) const
+{
+  if (currentSize == 0)
+  {
+    return 1;
+  }
+  if (pHandle != nullptr)
+  {
+    *pHandle = handles[root];
+  }
+  if (pKey != nullptr)
+  {
+    *pKey = keys[root];
+  }
+  return 0;
+}
+
+// Replace the root's key and restore the heap property below it
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::replaceMin(const Key &key, int *pHandle)
+{
+  if (currentSize == 0)
+  {
+    return 1;
+  }
+  if (pHandle != nullptr)
+  {
+    *pHandle = handles[root];
+  }
+  keys[root] = key;
+  percolateDown(root);
+  return 0;
+}
+
+// Remove a handle from anywhere in the heap by its position, so any key type works
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::remove(int handle, Key *pKey)
+{
+  if (!contains(handle))
+  {
+    return 1;
+  }
+
+  int pos = position[handle];
+  if (pKey != nullptr)
+  {
+    *pKey = keys[pos];
+  }
+  position[handle] = -1;
+
+  // Fill the hole with the last element, which may belong above or below it
+  int last = lastPos();
+  currentSize--;
+  if (pos != last)
+  {
+    bool rises = before(keys[last], keys[pos]);
+    HEAP_COUNT(moves, 1);
+    keys[pos] = std::move(keys[last]);
+    handles[pos] = handles[last];
+    if (rises)
+    {
+      percolateUp(pos);
+    }
+    else
+    {
+      percolateDown(pos);
+    }
+  }
+  return 0;
+}
+
+// Check whether a handle is in the heap
+template <typename Key, typename Compare, int arity>
+bool indexHeap<Key, Compare, arity>::contains(int handle) const
+{
+  return handle >= 0 && handle < capacity && position[handle] != -1;
+}
+
+// Grow the arrays to hold more handles
+template <typename Key, typename Compare, int arity>
+void indexHeap<Key, Compare, arity>::reserve(int newCapacity)
+{
+  if (newCapacity <= capacity)
+  {
+    return;
+  }
+  keys.resize(root + newCapacity);
+  handles.resize(root + newCapacity);
+  position.resize(newCapacity, -1);
+  capacity = newCapacity;
+}
+
+// Find the smallest of the children starting at position first
+template <typename Key, typename Compare, int arity>
+int indexHeap<Key, Compare, arity>::minChild(int first) const
+{
+  int last = lastPos();
+
+#ifdef __SSE2__
+  // A full group of 4 or 8 int children is one aligned load (or two)
+  if constexpr (simdKeys && arity > 2)
+  {
+    if (first + arity - 1 <= last)
+    {
+      HEAP_COUNT(comparisons, arity - 1);
+      return first + indexHeapDetail::minIndex(&keys[first], arity);
+    }
+  }
+#endif
+
+  int child = first;
+  int end = std::min(first + arity - 1, last);
+  for (int c = first + 1; c <= end; ++c)
+  {
+    if (before(keys[c], keys[child]))
+    {
+      child = c;
+    }
+  }
+  return child;
+}
+
+// Percolate an entry up the heap to restore the heap property
+template <typename Key, typename Compare, int arity>
+void indexHeap<Key, Compare, arity>::percolateUp(int posCur)
+{
+  Key tmpKey = std::move(keys[posCur]);
+  int tmpHandle = handles[posCur];
+
+  // Move the entry up the heap as long as it's smaller than its parent
+  for (; posCur > root && before(tmpKey, keys[parent(posCur)]); posCur = parent(posCur))
+  {
+    HEAP_COUNT(moves, 1);
+    keys[posCur] = std::move(keys[parent(posCur)]);
+    handles[posCur] = handles[parent(posCur)];
+    position[handles[posCur]] = posCur;
+  }
+
+  // Place the entry in its correct position
+  keys[posCur] = std::move(tmpKey);
+  handles[posCur] = tmpHandle;
+  position[tmpHandle] = posCur;
+}
+
+// Floyd's heapify: percolate down every node that has children, from the last one up,
+// which costs O(n) in total instead of O(n log n) for n inserts
+template <typename Key, typename Compare, int arity>
+void indexHeap<Key, Compare, arity>::heapify()
+{
+  if (currentSize > 1)
+  {
+    for (int pos = parent(lastPos()); pos >= root; --pos)
+    {
+      percolateDown(pos);
+    }
+  }
+}
+
+// Percolate an entry down the heap to restore the heap property
+template <typename Key, typename Compare, int arity>
+void indexHeap<Key, Compare, arity>::percolateDown(int posCur)
+{
+  Key tmpKey = std::move(keys[posCur]);
+  int tmpHandle = handles[posCur];
+
+  // Move the entry down the heap as long as it's larger than its smallest child
+  int child;
+  for (; firstChild(posCur) <= lastPos(); posCur = child)
+  {
+    child = minChild(firstChild(posCur));
+
+    // If the entry is no larger than the smallest child, stop percolating
+    if (!before(keys[child], tmpKey))
+    {
+      break;
+    }
+
+    HEAP_COUNT(moves, 1);
+    keys[posCur] = std::move(keys[child]);
+    handles[posCur] = handles[child];
+    position[handles[posCur]] = posCur;
+  }
+
+  // Place the entry in its correct position
+  keys[posCur] = std::move(tmpKey);
+  handles[posCur] = tmpHandle;
+  position[tmpHandle] = posCur;
+}
+
+#endif
@@ -0,0 +1,212 @@
+#ifndef _MULTIQUEUE_H
+#define _MULTIQUEUE_H
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <functional>
+#include <algorithm>
+#include "indexHeap.h"
+
+// A relaxed concurrent min-priority queue (MultiQueue) for many threads.
+// It holds queuesPerThread * threads sequential heaps, each behind its own lock.
+// insert puts an item into a random heap; deleteMin peeks at the tops of two
+// random heaps and pops the smaller one. Threads almost never wait on each other,
+// at the price of deleteMin returning an item near, not always at, the minimum.
+// Items carry a key and an optional data pointer; there are no ids.
+// The member definitions follow the class, since they depend on Key and Compare.
+template <typename Key = int, typename Compare = std::less<Key>, int arity = 4>
+class multiQueue
+{
+public:
+  // Constructor: sets up queuesPerThread heaps for each of the given number of threads
+  multiQueue(int threads, int queuesPerThread = 2, const Compare &compare = Compare());
+
+  // Inserts an item with the given key and optional data pointer
+  // Returns 0 on success
+  int insert(const Key &key, void *pv = nullptr);
+
+  // Deletes an item with a small key, optionally writing its key and data
+  // Returns 0 on success, 1 if every heap was empty
+  int deleteMin(Key *pKey = nullptr, void **ppData = nullptr);
+
+  // Returns the number of items; only exact when no other thread is using the queue
+  int size() const { return count.load(std::memory_order_relaxed); }
+
+private:
+  // One sequential heap and its lock, padded to a cache line of its own
+  struct alignas(64) subQueue
+  {
+    std::mutex lock;                      // Held while the heap is used
+    indexHeap<Key, Compare, arity> order; // Heap over the handles of the items queued here
+    std::vector<void *> data;             // data[handle] is the data pointer of that item
+    std::vector<int> freeHandles;         // Handles not currently in use
+
+    subQueue(const Compare &compare) : order(0, compare) {}
+  };
+
+  int queueCount;                                // Number of heaps
+  Compare less;                                  // less(a, b) is true if a belongs above b
+  std::vector<std::unique_ptr<subQueue>> queues; // The heaps, each allocated on its own cache line
+  std::atomic<int> count;                        // Number of items in all heaps
+
+  // Returns a random heap number, from a per-thread generator
+  int randomQueue();
+
+  // Pushes an item onto a locked heap
+  void push(subQueue &q, const Key &key, void *pv);
+
+  // Pops the minimum of a locked, non-empty heap
+  void pop(subQueue &q, Key *pKey, void **ppData);
+};
+
+// Constructor for creating the heaps
+template <typename Key, typename Compare, int arity>
+multiQueue<Key, Compare, arity>::multiQueue(int threads, int queuesPerThread, const Compare &compare)
+    : queueCount(std::max(2, threads * queuesPerThread)), less(compare), count(0)
+{
+  queues.reserve(queueCount);
+  for (int i = 0; i < queueCount; ++i)
+  {
+    queues.emplace_back(new subQueue(compare));
+  }
+}
+
+// Insert into the first random heap whose lock is free
+template <typename Key, typename Compare, int arity>
+int multiQueue<Key, Compare, arity>::insert(const Key &key, void *pv)
+{
+  for (;;)
+  {
+    subQueue &q = *queues[randomQueue()];
+    if (q.lock.try_lock())
+    {
+      push(q, key, pv);
+      q.lock.unlock();
+      count.fetch_add(1, std::memory_order_relaxed);
+      return 0;
+    }
+  }
+}
+
+// Pop the smaller top of two random heaps
+template <typename Key, typename Compare, int arity>
+int multiQueue<Key, Compare, arity>::deleteMin(Key *pKey, void **ppData)
+{
+  // After this many tries that find both heaps empty, check every heap before giving up
+  const int emptyTries = queueCount;
+
+  for (int tries = 0; tries < emptyTries;)
+  {
+    int i = randomQueue();
+    int j = randomQueue();
+    if (i == j)
+    {
+      continue;
+    }
+
+    // Peeking under the locks lets any key type be compared safely
+    subQueue &a = *queues[i];
+    subQueue &b = *queues[j];
+    if (!a.lock.try_lock())
+    {
+      continue;
+    }
+    if (!b.lock.try_lock())
+    {
+      a.lock.unlock();
+      continue;
+    }
+
+    subQueue *best = nullptr;
+    if (!a.order.empty() && !b.order.empty())
+    {
+      Key keyA, keyB;
+      a.order.peekMin(nullptr, &keyA);
+      b.order.peekMin(nullptr, &keyB);
+      best = less(keyB, keyA) ? &b : &a;
+    }
+    else if (!a.order.empty())
+    {
+      best = &a;
+    }
+    else if (!b.order.empty())
+    {
+      best = &b;
+    }
+
+    if (best != nullptr)
+    {
+      pop(*best, pKey, ppData);
+    }
+    b.lock.unlock();
+    a.lock.unlock();
+
+    if (best != nullptr)
+    {
+      count.fetch_sub(1, std::memory_order_relaxed);
+      return 0;
+    }
+    tries++;
+  }
+
+  // The random picks kept finding empty heaps, so look through all of them
+  for (int i = 0; i < queueCount; ++i)
+  {
+    std::lock_guard<std::mutex> guard(queues[i]->lock);
+    if (!queues[i]->order.empty())
+    {
+      pop(*queues[i], pKey, ppData);
+      count.fetch_sub(1, std::memory_order_relaxed);
+      return 0;
+    }
+  }
+  return 1;
+}
+
+// Pick a heap with a per-thread xorshift generator, which needs no locking
+template <typename Key, typename Compare, int arity>
+int multiQueue<Key, Compare, arity>::randomQueue()
+{
+  thread_local uint64_t state = 0x9E3779B97F4A7C15ULL ^ reinterpret_cast<uintptr_t>(&state);
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  return static_cast<int>((state >> 32) % queueCount);
+}
+
+// Give the item a free handle in the heap
+template <typename Key, typename Compare, int arity>
+void multiQueue<Key, Compare, arity>::push(subQueue &q, const Key &key, void *pv)
+{
+  int handle;
+  if (q.freeHandles.empty())
+  {
+    handle = q.data.size();
+    q.data.push_back(pv);
+  }
+  else
+  {
+    handle = q.freeHandles.back();
+    q.freeHandles.pop_back();
+    q.data[handle] = pv;
+  }
+  q.order.insert(handle, key);
+}
+
+// Take the heap's minimum and free its handle
+template <typename Key, typename Compare, int arity>
+void multiQueue<Key, Compare, arity>::pop(subQueue &q, Key *pKey, void **ppData)
+{
+  int handle;
+  q.order.deleteMin(&handle, pKey);
+  if (ppData != nullptr)
+  {
+    *ppData = q.data[handle];
+  }
+  q.freeHandles.push_back(handle);
+}
+
+#endif
@@ -0,0 +1,198 @@
+//
+// This program measures the MultiQueue against one heap behind one lock,
+// with 1 to 64 threads: throughput on an insert/deleteMin mix, and the
+// rank error of the MultiQueue, i.e. how many smaller keys were still
+// queued when each key came out.
+// Usage: multiQueueBench.exe [number of items] [max threads]
+//
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+
+#include "indexHeap.h"
+#include "multiQueue.h"
+
+using namespace std;
+using namespace std::chrono;
+
+// A heap made safe for threads the simple way, which is what the MultiQueue replaces
+class lockedHeap
+{
+public:
+  lockedHeap() : order(0) {}
+
+  void insert(int key)
+  {
+    lock_guard<mutex> guard(lock);
+    int handle;
+    if (freeHandles.empty())
+    {
+      handle = next++;
+    }
+    else
+    {
+      handle = freeHandles.back();
+      freeHandles.pop_back();
+    }
+    order.insert(handle, key);
+  }
+
+  int deleteMin(int *pKey)
+  {
+    lock_guard<mutex> guard(lock);
+    int handle;
+    if (order.deleteMin(&handle, pKey) != 0)
+    {
+      return 1;
+    }
+    freeHandles.push_back(handle);
+    return 0;
+  }
+
+private:
+  mutex lock;
+  indexHeap<int, less<int>, 4> order;
+  vector<int> freeHandles;
+  int next = 0;
+};
+
+// Each thread alternates insert and deleteMin; returns millions of operations per second
+template <typename Queue>
+double throughput(Queue &q, int items, int threads)
+{
+  mt19937 rng(365);
+  for (int i = 0; i < items; ++i)
+  {
+    q.insert(rng() % 1000000000);
+  }
+
+  int pairsPerThread = items / threads;
+  auto start = steady_clock::now();
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&q, pairsPerThread, t]()
+                         {
+                           mt19937 local(t + 1);
+                           int key;
+                           for (int i = 0; i < pairsPerThread; ++i)
+                           {
+                             q.insert(local() % 1000000000);
+                             q.deleteMin(&key);
+                           } });
+  }
+  for (thread &w : workers)
+  {
+    w.join();
+  }
+  double seconds = duration_cast<duration<double>>(steady_clock::now() - start).count();
+  return 2.0 * pairsPerThread * threads / seconds / 1e6;
+}
+
+// Drains a MultiQueue holding keys 0 .. items - 1 with several threads, then replays
+// the pops in the order they happened to find each one's rank among the keys left.
+// With more threads than cores, a thread descheduled between a pop and its ticket
+// makes its key look queued for longer, so the figures are only meaningful up to the core count.
+void rankError(int items, int threads, double &mean, int &worst)
+{
+  multiQueue<int, less<int>, 4> q(threads);
+  vector<int> keys(items);
+  for (int i = 0; i < items; ++i)
+  {
+    keys[i] = i;
+  }
+  shuffle(keys.begin(), keys.end(), mt19937(365));
+  for (int key : keys)
+  {
+    q.insert(key);
+  }
+
+  // The ticket taken right after a pop stands in for the moment it happened
+  vector<int> popped(items);
+  atomic<int> ticket(0);
+  vector<thread> workers;
+  for (int t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&]()
+                         {
+                           int key;
+                           while (q.deleteMin(&key) == 0)
+                           {
+                             popped[ticket.fetch_add(1)] = key;
+                           } });
+  }
+  for (thread &w : workers)
+  {
+    w.join();
+  }
+
+  // Fenwick tree over the keys still queued
+  vector<int> tree(items + 1, 0);
+  for (int i = 1; i <= items; ++i)
+  {
+    tree[i]++;
+    if (i + (i & -i) <= items)
+    {
+      tree[i + (i & -i)] += tree[i];
+    }
+  }
+
+  long long total = 0;
+  worst = 0;
+  for (int key : popped)
+  {
+    int smaller = 0;
+    for (int i = key; i > 0; i -= i & -i)
+    {
+      smaller += tree[i];
+    }
+    for (int i = key + 1; i <= items; i += i & -i)
+    {
+      tree[i]--;
+    }
+    total += smaller;
+    worst = max(worst, smaller);
+  }
+  mean = static_cast<double>(total) / items;
+}
+
+int main(int argc, char *argv[])
+{
+  int items = (argc > 1) ? atoi(argv[1]) : 1000000;
+  int maxThreads = (argc > 2) ? atoi(argv[2]) : 64;
+  if (items < 1 || maxThreads < 1)
+  {
+    cerr << "Error, the number of items and threads must be positive!\n";
+    exit(1);
+  }
+
+  cout << "Items: " << items << ", hardware threads: " << thread::hardware_concurrency()
+       << " (throughput in million operations per second)\n";
+  cout << right << setw(8) << "Threads" << setw(14) << "locked heap" << setw(14) << "MultiQueue"
+       << setw(14) << "mean rank" << setw(14) << "max rank" << "\n";
+  cout << fixed << setprecision(2);
+
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    lockedHeap locked;
+    multiQueue<int, less<int>, 4> relaxed(threads);
+    double lockedRate = throughput(locked, items, threads);
+    double relaxedRate = throughput(relaxed, items, threads);
+
+    double mean;
+    int worst;
+    rankError(items, threads, mean, worst);
+
+    cout << setw(8) << threads << setw(14) << lockedRate << setw(14) << relaxedRate
+         << setw(14) << mean << setw(14) << worst << "\n";
+  }
+  return 0;
+}
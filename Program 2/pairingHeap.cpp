@@ -0,0 +1,310 @@
+/* Name: Talha Akhlaq
+   Implements a pairing heap keyed by string IDs. Each node points to its leftmost child and its
+   siblings, and a hash table maps IDs to nodes. Decreasing a key cuts the node's subtree and links it
+   with the root; deleteMin merges the root's children back together in two passes.
+*/
+
+#include "pairingHeap.h"
+#include <utility>
+#include <algorithm>
+
+using namespace std;
+
+// Constructor for initializing heap with a given capacity
+pairingHeap::pairingHeap(int capacity)
+    : capacity(0), currentSize(0), root(nullptr)
+{
+  addPool(capacity);
+  mapping = hashTable(capacity * 2); // Initialize hash table for quick lookups
+}
+
+// Insert a node into the heap with the specified ID and key
+int pairingHeap::insert(const std::string &id, int key, void *pv)
+{
+  if (mapping.contains(id))
+  {
+    return 2;
+  }
+
+  if (freeNodes.empty())
+  {
+    addPool(max(1, capacity));
+  }
+
+  node *pn = freeNodes.back();
+  if (mapping.insert(id, pn) != 0)
+  {
+    return 3; // Error code for hash table insertion failure
+  }
+  freeNodes.pop_back();
+
+  pn->id = id;
+  pn->key = key;
+  pn->pData = pv;
+  pn->child = pn->next = pn->prev = nullptr;
+  root = (root == nullptr) ? pn : link(root, pn);
+  currentSize++;
+  return 0;
+}
+
+// Set the key of the node with the given ID and adjust the heap accordingly
+int pairingHeap::setKey(const std::string &id, int key)
+{
+  node *pn = find(id);
+  if (pn == nullptr)
+  {
+    return 1;
+  }
+
+  if (key < pn->key)
+  {
+    // The subtree stays heap-ordered, so it only has to be linked with the root
+    pn->key = key;
+    if (pn != root)
+    {
+      cut(pn);
+      root = link(root, pn);
+    }
+  }
+  else if (key > pn->key)
+  {
+    // The children may now be smaller, so take the node out and put it back alone
+    detach(pn);
+    pn->key = key;
+    root = (root == nullptr) ? pn : link(root, pn);
+  }
+  return 0;
+}
+
+// Delete the node with the smallest key (the root of the heap) and return its details
+int pairingHeap::deleteMin(std::string *pId, int *pKey, void **ppData)
+{
+  if (root == nullptr)
+  {
+    return 1;
+  }
+
+  node *pn = root;
+  detach(pn);
+  release(pn, pId, pKey, ppData);
+  return 0;
+}
+
+// Remove the node with the specified ID from the heap and return its details
+int pairingHeap::remove(const std::string &id, int *pKey, void **ppData)
+{
+  node *pn = find(id);
+  if (pn == nullptr)
+  {
+    return 1;
+  }
+
+  detach(pn);
+  release(pn, nullptr, pKey, ppData);
+  return 0;
+}
+
+// Move all of other's nodes into this heap
+int pairingHeap::meld(pairingHeap &other)
+{
+  if (&other == this)
+  {
+    return 1;
+  }
+
+  // Collect other's nodes, refusing the meld if any id is already here
+  vector<node *> moved;
+  moved.reserve(other.currentSize);
+  scratch.clear();
+  if (other.root != nullptr)
+  {
+    scratch.push_back(other.root);
+  }
+  while (!scratch.empty())
+  {
+    node *pn = scratch.back();
+    scratch.pop_back();
+    if (mapping.contains(pn->id))
+    {
+      return 2;
+    }
+    moved.push_back(pn);
+    if (pn->child != nullptr)
+    {
+      scratch.push_back(pn->child);
+    }
+    if (pn->next != nullptr)
+    {
+      scratch.push_back(pn->next);
+    }
+  }
+
+  // Other's table is only cleared once every id is in this one, so a failed insert can be undone
+  for (size_t k = 0; k < moved.size(); ++k)
+  {
+    if (mapping.insert(moved[k]->id, moved[k]) != 0)
+    {
+      for (size_t j = 0; j < k; ++j)
+      {
+        mapping.remove(moved[j]->id);
+      }
+      return 3;
+    }
+  }
+  for (node *pn : moved)
+  {
+    other.mapping.remove(pn->id);
+  }
+
+  // Moving a pool keeps its nodes where they are, so no pointer changes
+  for (auto &pool : other.pools)
+  {
+    pools.push_back(std::move(pool));
+  }
+  freeNodes.insert(freeNodes.end(), other.freeNodes.begin(), other.freeNodes.end());
+
+  if (other.root != nullptr)
+  {
+    root = (root == nullptr) ? other.root : link(root, other.root);
+  }
+  capacity += other.capacity;
+  currentSize += other.currentSize;
+
+  other.pools.clear();
+  other.freeNodes.clear();
+  other.root = nullptr;
+  other.capacity = 0;
+  other.currentSize = 0;
+  return 0;
+}
+
+// Add a pool of nodes; earlier pools stay where they are, so node pointers remain valid
+void pairingHeap::addPool(int nodes)
+{
+  pools.push_back(vector<node>(nodes));
+  vector<node> &pool = pools.back();
+
+  // Hand out the first node of the pool first
+  freeNodes.reserve(freeNodes.size() + nodes);
+  for (int n = nodes - 1; n >= 0; --n)
+  {
+    freeNodes.push_back(&pool[n]);
+  }
+  capacity += nodes;
+}
+
+// Link two trees; the root with the larger key becomes the leftmost child of the other
+pairingHeap::node *pairingHeap::link(node *a, node *b)
+{
+  if (b->key < a->key)
+  {
+    std::swap(a, b);
+  }
+
+  b->prev = a;
+  b->next = a->child;
+  if (a->child != nullptr)
+  {
+    a->child->prev = b;
+  }
+  a->child = b;
+  a->next = a->prev = nullptr;
+  return a;
+}
+
+// Unlink a node and its subtree from the rest of the heap
+void pairingHeap::cut(node *pn)
+{
+  if (pn->prev->child == pn)
+  {
+    pn->prev->child = pn->next;
+  }
+  else
+  {
+    pn->prev->next = pn->next;
+  }
+  if (pn->next != nullptr)
+  {
+    pn->next->prev = pn->prev;
+  }
+  pn->next = pn->prev = nullptr;
+}
+
+// Pair up siblings left to right, then link the pairs right to left
+pairingHeap::node *pairingHeap::mergePairs(node *first)
+{
+  if (first == nullptr)
+  {
+    return nullptr;
+  }
+
+  scratch.clear();
+  while (first != nullptr)
+  {
+    node *a = first;
+    node *b = a->next;
+    if (b == nullptr)
+    {
+      a->next = a->prev = nullptr;
+      scratch.push_back(a);
+      break;
+    }
+    first = b->next;
+    scratch.push_back(link(a, b));
+  }
+
+  node *merged = scratch.back();
+  for (int i = static_cast<int>(scratch.size()) - 2; i >= 0; --i)
+  {
+    merged = link(scratch[i], merged);
+  }
+  return merged;
+}
+
+// Take a node out of the heap and merge its children back in
+void pairingHeap::detach(node *pn)
+{
+  node *children = mergePairs(pn->child);
+  pn->child = nullptr;
+
+  if (pn == root)
+  {
+    root = children;
+  }
+  else
+  {
+    cut(pn);
+    if (children != nullptr)
+    {
+      root = link(root, children);
+    }
+  }
+}
+
+// Find the node of an ID through the hash table
+pairingHeap::node *pairingHeap::find(const std::string &id)
+{
+  bool found = false;
+  node *pn = static_cast<node *>(mapping.getPointer(id, &found));
+  return found ? pn : nullptr;
+}
+
+// Drop the ID mapping for a node and return it to the pool
+void pairingHeap::release(node *pn, std::string *pId, int *pKey, void **ppData)
+{
+  if (pKey != nullptr)
+  {
+    *pKey = pn->key;
+  }
+  if (ppData != nullptr)
+  {
+    *ppData = pn->pData;
+  }
+  mapping.remove(pn->id);
+  if (pId != nullptr)
+  {
+    *pId = std::move(pn->id);
+  }
+  freeNodes.push_back(pn);
+  currentSize--;
+}
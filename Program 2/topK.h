@@ -0,0 +1,174 @@
+#ifndef _TOPK_H
+#define _TOPK_H
+
+#include <vector>
+#include <functional>
+#include <type_traits>
+#include "indexHeap.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Keeps the k best items of a stream, where a is better than b if compare(a, b):
+// the k smallest keys with the default std::less, the k largest with std::greater.
+// The kept items sit in a heap with the worst of them at the root, so an item
+// that is no better than the root is turned away with one comparison, and a
+// better one replaces the root in place. Memory stays at k items however long
+// the stream is.
+// The member definitions follow the class, since they depend on Key and Compare.
+template <typename Key = int, typename Compare = std::less<Key>, int arity = 4>
+class topK
+{
+public:
+  // Constructor: keeps at most k items
+  topK(int k, const Compare &compare = Compare());
+
+  // Offers one item with an optional data pointer
+  // Returns true if it was kept
+  bool offer(const Key &key, void *pv = nullptr);
+
+  // Offers n items at once; data, if given, holds the data pointer of each key.
+  // For int keys in std::less or std::greater order, SSE2 compares 8 keys at a time
+  // with the current worst kept key, so most of a long stream never reaches the heap.
+  // Returns the number of items kept
+  int offerMany(const Key *keys, int n, void *const *data = nullptr);
+
+  // Returns the number of items kept so far
+  int size() const { return order.size(); }
+
+  // Writes the kept keys (and data, if asked) best first, and empties the heap
+  void extract(std::vector<Key> &keys, std::vector<void *> *data = nullptr);
+
+private:
+  // Orders the heap worst first, so its root is the item to replace
+  struct worseFirst
+  {
+    Compare better; // better(a, b) is true if a should be kept ahead of b
+
+    bool operator()(const Key &a, const Key &b) const { return better(b, a); }
+  };
+
+  // Whether offerMany may compare with SSE2
+  static constexpr bool simdLess = std::is_same<Key, int>::value && std::is_same<Compare, std::less<int>>::value;
+  static constexpr bool simdGreater = std::is_same<Key, int>::value && std::is_same<Compare, std::greater<int>>::value;
+
+  int k;                                   // Number of items to keep
+  Compare better;                          // better(a, b) is true if a should be kept ahead of b
+  indexHeap<Key, worseFirst, arity> order; // The kept items, handles 0 .. k - 1, worst at the root
+  std::vector<void *> data;                // data[handle] is the data pointer of that item
+  Key worst;                               // Key at the root, valid once k items are kept
+};
+
+// Constructor for an empty selection of k items
+template <typename Key, typename Compare, int arity>
+topK<Key, Compare, arity>::topK(int k, const Compare &compare)
+    : k(k < 0 ? 0 : k), better(compare), order(k < 0 ? 0 : k, worseFirst{compare}), data(k < 0 ? 0 : k)
+{
+}
+
+// Keep the item if there is room or it beats the worst kept item
+template <typename Key, typename Compare, int arity>
+bool topK<Key, Compare, arity>::offer(const Key &key, void *pv)
+{
+  int handle = 0;
+  if (order.size() < k)
+  {
+    // Still filling up: every item is kept, under the next free handle
+    handle = order.size();
+    order.insert(handle, key);
+  }
+  else if (k == 0 || !better(key, worst))
+  {
+    return false;
+  }
+  else
+  {
+    order.replaceMin(key, &handle);
+  }
+
+  data[handle] = pv;
+  if (order.size() == k)
+  {
+    order.peekMin(nullptr, &worst);
+  }
+  return true;
+}
+
+// Offer a block of items, skipping blocks of 8 that cannot beat the worst kept key
+template <typename Key, typename Compare, int arity>
+int topK<Key, Compare, arity>::offerMany(const Key *keys, int n, void *const *data)
+{
+  int kept = 0;
+  int i = 0;
+
+  // Until the heap is full there is no worst key to filter with
+  for (; i < n && order.size() < k; ++i)
+  {
+    kept += offer(keys[i], data != nullptr ? data[i] : nullptr);
+  }
+
+#ifdef __SSE2__
+  if constexpr (simdLess || simdGreater)
+  {
+    if (k > 0)
+    {
+      for (; i + 8 <= n; i += 8)
+      {
+        // The worst key only gets better, so keys that lose to it now would lose later too
+        __m128i threshold = _mm_set1_epi32(worst);
+        __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i));
+        __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i *>(keys + i + 4));
+        __m128i lowWins, highWins;
+        if constexpr (simdLess)
+        {
+          lowWins = _mm_cmplt_epi32(low, threshold);
+          highWins = _mm_cmplt_epi32(high, threshold);
+        }
+        else
+        {
+          lowWins = _mm_cmpgt_epi32(low, threshold);
+          highWins = _mm_cmpgt_epi32(high, threshold);
+        }
+
+        int mask = _mm_movemask_ps(_mm_castsi128_ps(lowWins)) | (_mm_movemask_ps(_mm_castsi128_ps(highWins)) << 4);
+        while (mask != 0)
+        {
+          int j = i + __builtin_ctz(mask);
+          mask &= mask - 1;
+          kept += offer(keys[j], data != nullptr ? data[j] : nullptr); // Checked again, as worst may have moved
+        }
+      }
+    }
+  }
+#endif
+
+  for (; i < n; ++i)
+  {
+    kept += offer(keys[i], data != nullptr ? data[i] : nullptr);
+  }
+  return kept;
+}
+
+// Drain the heap worst first, filling the output from the back
+template <typename Key, typename Compare, int arity>
+void topK<Key, Compare, arity>::extract(std::vector<Key> &keys, std::vector<void *> *pData)
+{
+  int count = order.size();
+  keys.resize(count);
+  if (pData != nullptr)
+  {
+    pData->resize(count);
+  }
+
+  for (int i = count - 1; i >= 0; --i)
+  {
+    int handle;
+    order.deleteMin(&handle, &keys[i]);
+    if (pData != nullptr)
+    {
+      (*pData)[i] = data[handle];
+    }
+  }
+}
+
+#endif
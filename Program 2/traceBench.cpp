@@ -0,0 +1,341 @@
+//
+// This program replays one trace of heap operations on the heap through
+// string ids, on the handle heap, and on a std::priority_queue that
+// handles setKey and remove by lazy deletion, and times each of them.
+// The trace is a random mix of insert, setKey, deleteMin and remove in
+// the given percentages, with keys that arrive in sorted order, in random
+// order, or adversarially (every new key is the new minimum).
+// Built with -DHEAP_STATS (make stats), it also prints the comparisons,
+// moves and hash table calls the heap makes per operation.
+// Usage: traceBench.exe [sorted|random|adversarial] [operations] [insert% setKey% deleteMin% remove%]
+//
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <set>
+#include <queue>
+#include <random>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <functional>
+
+#include "heap.h"
+#include "indexHeap.h"
+#include "heapStats.h"
+
+using namespace std;
+using namespace std::chrono;
+
+enum opType
+{
+  opInsert,
+  opSetKey,
+  opDeleteMin,
+  opRemove
+};
+
+const char *opNames[] = {"insert", "setKey", "deleteMin", "remove"};
+
+// One step of a trace; for deleteMin, id and key are what must come out
+struct traceOp
+{
+  opType type;
+  int id;
+  int key;
+};
+
+vector<string> ids; // ids[i] is the string id of item i
+
+// Make the next key of the trace; every key is distinct, so every heap pops the same items
+int nextKey(const string &order, int &serial)
+{
+  unsigned int s = serial++;
+  if (order == "sorted")
+  {
+    return s;
+  }
+  if (order == "adversarial")
+  {
+    return INT_MAX - s;
+  }
+  return (s * 2654435761u) & 0x7fffffff; // Odd multiplier, so distinct serials give distinct keys
+}
+
+// Build a trace, following along with an ordered set to know what each deleteMin returns
+vector<traceOp> makeTrace(const string &order, int operations, const int percent[4])
+{
+  vector<traceOp> trace;
+  trace.reserve(operations);
+  mt19937 rng(365);
+  set<pair<int, int>> queued;   // (key, id) of every item in the heap
+  vector<int> live;             // Ids in the heap, for picking one at random
+  vector<int> slot, key;        // slot[id] is its index in live, key[id] its current key
+  int serial = 0;
+
+  for (int i = 0; i < operations; ++i)
+  {
+    int pick = rng() % 100;
+    opType type = opInsert;
+    for (int t = 0, sum = 0; t < 4; ++t)
+    {
+      sum += percent[t];
+      if (pick < sum)
+      {
+        type = static_cast<opType>(t);
+        break;
+      }
+    }
+    if (live.empty())
+    {
+      type = opInsert;
+    }
+
+    traceOp op = {type, 0, 0};
+    if (type == opInsert)
+    {
+      op.id = slot.size();
+      op.key = nextKey(order, serial);
+      slot.push_back(live.size());
+      key.push_back(op.key);
+      live.push_back(op.id);
+      queued.insert({op.key, op.id});
+    }
+    else
+    {
+      if (type == opDeleteMin)
+      {
+        op.id = queued.begin()->second;
+      }
+      else
+      {
+        op.id = live[rng() % live.size()];
+      }
+      queued.erase({key[op.id], op.id});
+
+      if (type == opSetKey)
+      {
+        op.key = nextKey(order, serial);
+        key[op.id] = op.key;
+        queued.insert({op.key, op.id});
+      }
+      else
+      {
+        op.key = key[op.id];
+        live[slot[op.id]] = live.back();
+        slot[live.back()] = slot[op.id];
+        live.pop_back();
+      }
+    }
+    trace.push_back(op);
+  }
+
+  ids.resize(slot.size());
+  for (size_t i = 0; i < ids.size(); ++i)
+  {
+    ids[i] = "item" + to_string(i);
+  }
+  return trace;
+}
+
+// A std::priority_queue with setKey and remove by lazy deletion: setKey pushes
+// a second entry, and entries whose key is no longer their item's are skipped
+// when they reach the top
+class lazyQueue
+{
+public:
+  lazyQueue(int items) : key(items, -1) {}
+
+  void insert(int id, int k)
+  {
+    key[id] = k;
+    entries.push({k, id});
+    peak = max(peak, entries.size());
+  }
+
+  void setKey(int id, int k) { insert(id, k); }
+
+  bool deleteMin(int *pId, int *pKey)
+  {
+    while (!entries.empty())
+    {
+      pair<int, int> top = entries.top();
+      entries.pop();
+      if (key[top.second] == top.first)
+      {
+        key[top.second] = -1;
+        *pId = top.second;
+        *pKey = top.first;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void remove(int id) { key[id] = -1; }
+
+  size_t peakSize() const { return peak; }
+
+private:
+  priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> entries;
+  vector<int> key; // key[id] is the item's current key, or -1 once it is gone
+  size_t peak = 0; // Most entries ever held, stale ones included
+};
+
+// Replay one operation on each kind of heap; returns false if deleteMin gave the wrong item
+bool replay(heap<int> &h, const traceOp &op)
+{
+  string id;
+  int key;
+  switch (op.type)
+  {
+  case opInsert:
+    return h.insert(ids[op.id], op.key) == 0;
+  case opSetKey:
+    return h.setKey(ids[op.id], op.key) == 0;
+  case opDeleteMin:
+    return h.deleteMin(&id, &key) == 0 && id == ids[op.id] && key == op.key;
+  default:
+    return h.remove(ids[op.id]) == 0;
+  }
+}
+
+bool replay(indexHeap<int> &h, const traceOp &op)
+{
+  int handle, key;
+  switch (op.type)
+  {
+  case opInsert:
+    return h.insert(op.id, op.key) == 0;
+  case opSetKey:
+    return h.setKey(op.id, op.key) == 0;
+  case opDeleteMin:
+    return h.deleteMin(&handle, &key) == 0 && handle == op.id && key == op.key;
+  default:
+    return h.remove(op.id) == 0;
+  }
+}
+
+bool replay(lazyQueue &q, const traceOp &op)
+{
+  int id, key;
+  switch (op.type)
+  {
+  case opInsert:
+    q.insert(op.id, op.key);
+    return true;
+  case opSetKey:
+    q.setKey(op.id, op.key);
+    return true;
+  case opDeleteMin:
+    return q.deleteMin(&id, &key) && id == op.id && key == op.key;
+  default:
+    q.remove(op.id);
+    return true;
+  }
+}
+
+// Replay the whole trace and return the time in milliseconds
+template <typename Heap>
+double timeReplay(Heap &h, const vector<traceOp> &trace, bool &ok)
+{
+  auto start = steady_clock::now();
+  for (const traceOp &op : trace)
+  {
+    if (!replay(h, op))
+    {
+      ok = false;
+    }
+  }
+  return duration_cast<duration<double, milli>>(steady_clock::now() - start).count();
+}
+
+#ifdef HEAP_STATS
+// Replay the trace on the string-id heap, adding up the counters by operation type
+void printStats(const vector<traceOp> &trace)
+{
+  heap<int> h(1);
+  heapStats total[4];
+  long long count[4] = {0, 0, 0, 0};
+  for (const traceOp &op : trace)
+  {
+    heapCounters.reset();
+    replay(h, op);
+    total[op.type].comparisons += heapCounters.comparisons;
+    total[op.type].moves += heapCounters.moves;
+    total[op.type].hashCalls += heapCounters.hashCalls;
+    count[op.type]++;
+  }
+
+  cout << "\n" << left << setw(12) << "Per call" << right << setw(10) << "calls" << setw(14) << "comparisons"
+       << setw(10) << "moves" << setw(12) << "hash calls" << "\n";
+  cout << fixed << setprecision(2);
+  for (int t = 0; t < 4; ++t)
+  {
+    double calls = max(1LL, count[t]);
+    cout << left << setw(12) << opNames[t] << right << setw(10) << count[t]
+         << setw(14) << total[t].comparisons / calls << setw(10) << total[t].moves / calls
+         << setw(12) << total[t].hashCalls / calls << "\n";
+  }
+}
+#endif
+
+int main(int argc, char *argv[])
+{
+  string order = (argc > 1) ? argv[1] : "random";
+  int operations = (argc > 2) ? atoi(argv[2]) : 1000000;
+  int percent[4] = {40, 30, 20, 10};
+  if (argc > 3 && argc != 7)
+  {
+    cerr << "Error, give all four percentages or none!\n";
+    exit(1);
+  }
+  for (int t = 0; argc > 3 && t < 4; ++t)
+  {
+    percent[t] = atoi(argv[3 + t]);
+  }
+
+  if (order != "sorted" && order != "random" && order != "adversarial")
+  {
+    cerr << "Error, key order must be sorted, random or adversarial!\n";
+    exit(1);
+  }
+  if (operations < 1)
+  {
+    cerr << "Error, the number of operations must be positive!\n";
+    exit(1);
+  }
+  if (percent[0] < 1 || percent[1] < 0 || percent[2] < 0 || percent[3] < 0 ||
+      percent[0] + percent[1] + percent[2] + percent[3] != 100)
+  {
+    cerr << "Error, the percentages must add up to 100, with some inserts!\n";
+    exit(1);
+  }
+
+  vector<traceOp> trace = makeTrace(order, operations, percent);
+  cout << "Operations: " << operations << ", " << order << " keys, " << percent[0] << "% insert, "
+       << percent[1] << "% setKey, " << percent[2] << "% deleteMin, " << percent[3] << "% remove (times in ms)\n";
+
+  bool ok = true;
+  heap<int> idHeap(1);
+  indexHeap<int> handleHeap(1);
+  lazyQueue lazy(ids.size());
+  cout << fixed << setprecision(1);
+  cout << left << setw(44) << "heap (string ids)" << right << setw(10) << timeReplay(idHeap, trace, ok) << "\n";
+  cout << left << setw(44) << "indexHeap (handles)" << right << setw(10) << timeReplay(handleHeap, trace, ok) << "\n";
+  cout << left << setw(44) << "priority_queue, lazy deletion (handles)" << right << setw(10) << timeReplay(lazy, trace, ok) << "\n";
+  cout << "Lazy queue peak size: " << lazy.peakSize() << " entries\n";
+
+#ifdef HEAP_STATS
+  printStats(trace);
+#endif
+
+  if (!ok)
+  {
+    cerr << "Error, a heap did not follow the trace!\n";
+    exit(1);
+  }
+  return 0;
+}
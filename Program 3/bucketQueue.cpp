@@ -0,0 +1,75 @@
+/* Name: Talha Akhlaq
+   Description: Implements Dial's bucket queue as a ring of buckets indexed by key. deleteMin advances
+   a cursor to the next non-empty bucket, so the cost of a whole Dijkstra run is the number of entries
+   plus the largest distance reached.
+*/
+
+#include "bucketQueue.h"
+
+using namespace std;
+
+// Constructor starts with a small ring positioned at key zero.
+bucketQueue::bucketQueue(int)
+    : currentSize(0), cursor(0), mask(63), buckets(64)
+{
+}
+
+// Inserts an entry into the bucket for its key, growing the ring if the key is beyond it.
+int bucketQueue::insert(int key, int id)
+{
+    if (key < cursor)
+        return 1; // Key is below the current minimum.
+
+    if (static_cast<unsigned int>(key - cursor) > mask)
+        grow(key);
+
+    entry e = {key, id};
+    buckets[key & mask].push_back(e);
+    currentSize++;
+    return 0;
+}
+
+// Removes an entry with the smallest key and returns its details.
+int bucketQueue::deleteMin(int *pKey, int *pId)
+{
+    if (currentSize == 0)
+        return 1; // Queue is empty.
+
+    // Every key is within the ring ahead of the cursor, so the next non-empty bucket holds the minimum.
+    while (buckets[cursor & mask].empty())
+        cursor++;
+
+    vector<entry> &bucket = buckets[cursor & mask];
+    entry e = bucket.back();
+    bucket.pop_back();
+    currentSize--;
+
+    if (pKey)
+        *pKey = e.key;
+    if (pId)
+        *pId = e.id;
+    return 0;
+}
+
+// Reports whether the queue has no entries left.
+bool bucketQueue::empty() const
+{
+    return currentSize == 0;
+}
+
+// Doubles the ring until key fits, then redistributes the entries.
+void bucketQueue::grow(int key)
+{
+    unsigned int size = mask + 1;
+    while (static_cast<unsigned int>(key - cursor) >= size)
+        size *= 2;
+
+    vector<vector<entry>> old(size);
+    old.swap(buckets);
+    mask = size - 1;
+    for (vector<entry> &bucket : old)
+    {
+        for (const entry &e : bucket)
+            buckets[e.key & mask].push_back(e);
+    }
+}
@@ -0,0 +1,47 @@
+#ifndef _BUCKETQUEUE_H
+#define _BUCKETQUEUE_H
+
+#include <vector>
+
+using namespace std;
+
+// Dial's bucket queue for non-negative integer keys that are extracted in non-decreasing order.
+// While the largest edge weight is C, every queued key lies within C of the current minimum,
+// so a ring of more than C buckets, one per key, needs no ordering at all. The ring starts
+// small and doubles whenever a key lands beyond it, which suits graphs with small weights.
+// Like radixHeap, items are not tracked by id and stale entries are left for the caller to skip.
+class bucketQueue
+{
+public:
+    // Constructor: Takes the expected number of items like the other queues; the ring grows as needed.
+    bucketQueue(int capacity);
+
+    // Inserts an entry with the given key and item number.
+    // Returns 0 on success, 1 if the key is below the current minimum.
+    int insert(int key, int id);
+
+    // Deletes an entry with the smallest key and optionally returns its key and item number.
+    // Returns 0 on success, 1 if the queue is empty.
+    int deleteMin(int *pKey = nullptr, int *pId = nullptr);
+
+    // Returns true if the queue holds no entries.
+    bool empty() const;
+
+private:
+    // Represents one queued entry.
+    struct entry
+    {
+        int key;     // Entry key.
+        int id;      // Item number, e.g. a vertex.
+    };
+
+    int currentSize;               // Number of entries in the queue.
+    int cursor;                    // No queued key is below this.
+    unsigned int mask;             // Ring size minus one; the ring size is a power of two.
+    vector<vector<entry>> buckets; // buckets[key & mask] holds the entries with that key.
+
+    // Enlarges the ring so that key fits, moving every entry to its new bucket.
+    void grow(int key);
+};
+
+#endif
@@ -0,0 +1,48 @@
+/*
+   Name: Talha Akhlaq
+   Description: Builds the contraction hierarchy of a graph and writes it to a file, so that pathBench.exe
+   can load it instead of contracting the graph on every run. The file records the graph's vertex and
+   edge counts and a fingerprint of its edges, and is refused for any other graph.
+   Usage: buildHierarchy.exe <graph file> <hierarchy file>
+*/
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include "graph.h"
+#include "contractionHierarchy.h"
+
+using namespace std;
+using namespace std::chrono;
+
+int main(int argc, char *argv[])
+{
+  if (argc != 3)
+  {
+    cerr << "Usage: " << argv[0] << " <graph file> <hierarchy file>" << endl;
+    return 1;
+  }
+
+  Graph graph(argv[1]);
+  contractionHierarchy hierarchy;
+
+  auto start = steady_clock::now();
+  if (hierarchy.build(graph) != 0)
+  {
+    cerr << "Error: Contraction hierarchies need non-negative edge weights." << endl;
+    return 1;
+  }
+  double buildTime = duration<double>(steady_clock::now() - start).count();
+
+  if (hierarchy.save(argv[2]) != 0)
+  {
+    cerr << "Error: Could not write file " << argv[2] << endl;
+    return 1;
+  }
+
+  cout << "Contracted " << graph.vertexCount() << " vertices and " << graph.edgeCount() << " edges in "
+       << buildTime << " s" << endl;
+  cout << "Shortcuts: " << hierarchy.shortcutCount() << ", core vertices: " << hierarchy.coreSize() << ", hierarchy size: "
+       << hierarchy.memoryBytes() / 1048576.0 << " MB" << endl;
+  return 0;
+}
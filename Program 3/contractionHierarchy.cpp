@@ -0,0 +1,727 @@
+/* Name: Talha Akhlaq
+   Description: Implements contraction hierarchies: vertices are contracted in order of a lazily updated
+   edge difference, with bounded witness searches deciding which shortcuts are needed; the result is
+   stored as upward and downward adjacency arrays, written to and read from a binary file, and queried
+   with a bidirectional upward search whose shortcuts are expanded back into graph edges.
+*/
+
+#include "contractionHierarchy.h"
+#include "radixHeap.h"
+#include <fstream>
+#include <climits>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+namespace
+{
+    // Most vertices a witness search settles before giving up; giving up early only costs an extra shortcut.
+    const int witnessSettleLimit = 100;
+
+    // Average number of arcs per remaining vertex at which contraction stops and the rest is left as the core.
+    const int coreDegree = 16;
+
+    // Identifies a hierarchy file; the version changes whenever the layout does.
+    const char hierarchyMagic[8] = {'D', 'J', 'K', 'C', 'H', 'I', 'E', 'R'};
+    const uint32_t hierarchyVersion = 2;
+
+    // Header of a hierarchy file. The rank array, the up offsets and arcs, and the down offsets and arcs follow.
+    struct hierarchyHeader
+    {
+        char magic[8];       // hierarchyMagic.
+        uint32_t version;    // hierarchyVersion.
+        int32_t vertexCount; // Number of vertices of the graph.
+        int64_t graphEdges;  // Number of edges of the graph.
+        uint64_t graphHash;  // graphFingerprint of the graph.
+        int64_t upCount;     // Number of upward arcs.
+        int64_t downCount;   // Number of downward arcs.
+        int64_t shortcuts;   // Number of shortcuts among them.
+        int64_t core;        // Number of vertices left uncontracted.
+    };
+
+    // An edge of the graph being contracted.
+    struct workArc
+    {
+        int other;  // The vertex at the other end.
+        int weight; // Length of the edge.
+        int middle; // Vertex the shortcut bypasses, or -1.
+    };
+
+    // The graph as contraction goes on. A contracted vertex's arcs are moved out of the remaining graph
+    // into upward and downward lists, since every vertex they still reach is more important.
+    class contractor
+    {
+    public:
+        vector<vector<workArc>> out;  // Arcs leaving each remaining vertex.
+        vector<vector<workArc>> in;   // Arcs entering each remaining vertex, with other the source.
+        vector<vector<workArc>> up;   // Arcs leaving each contracted vertex, to more important vertices.
+        vector<vector<workArc>> down; // Arcs entering each contracted vertex, from more important vertices.
+        vector<int> rank;             // Contraction order, the core last.
+        int shortcuts;                // Shortcuts added.
+        int core;                     // Vertices left uncontracted.
+
+        // Copies the graph's edges, keeping the lightest of parallel edges and dropping loops.
+        contractor(const Graph &graph);
+
+        // Contracts the vertices, least important first, until the remaining graph is dense.
+        void run();
+
+    private:
+        vector<int> deletedNeighbors; // Number of each vertex's neighbours already contracted.
+        long long liveArcs;           // Arcs between remaining vertices.
+
+        // Working state of the witness searches.
+        vector<int> distance;
+        vector<uint32_t> stamp;
+        vector<uint32_t> wanted; // epoch for the targets of the current witness search.
+        uint32_t epoch;
+        vertexHeap witnessQueue;
+
+        // Adds the arc u -> w, or lowers the weight of an existing one.
+        void addArc(int u, int w, int weight, int middle);
+
+        // Removes the arcs of v from the lists of its neighbours.
+        void detach(int v);
+
+        // Runs Dijkstra's algorithm from source among the remaining vertices other than skip, stopping
+        // once every vertex skip leads to is settled, beyond limit, or after witnessSettleLimit vertices.
+        void witnessSearch(int source, int skip, long long limit);
+
+        // Returns the distance the last witness search found to w, or LLONG_MAX.
+        long long witnessDistance(int w) const { return stamp[w] == epoch ? distance[w] : LLONG_MAX; }
+
+        // Counts the shortcuts contracting v would need, adding them unless simulate is set.
+        int contract(int v, bool simulate);
+
+        // Returns v's importance: shortcuts needed minus arcs removed, plus contracted neighbours.
+        int priority(int v);
+    };
+
+    contractor::contractor(const Graph &graph)
+        : out(graph.vertexCount()), in(graph.vertexCount()), up(graph.vertexCount()), down(graph.vertexCount()),
+          rank(graph.vertexCount(), -1), shortcuts(0), core(0), deletedNeighbors(graph.vertexCount(), 0), liveArcs(0),
+          distance(graph.vertexCount(), 0), stamp(graph.vertexCount(), 0), wanted(graph.vertexCount(), 0), epoch(0),
+          witnessQueue(graph.vertexCount())
+    {
+        for (int u = 0; u < graph.vertexCount(); u++)
+        {
+            const int *targets, *weights;
+            int count = graph.outEdges(u, targets, weights);
+            for (int e = 0; e < count; e++)
+            {
+                if (targets[e] != u)
+                    addArc(u, targets[e], weights[e], -1);
+            }
+        }
+    }
+
+    void contractor::addArc(int u, int w, int weight, int middle)
+    {
+        for (workArc &a : out[u])
+        {
+            if (a.other != w)
+                continue;
+            if (weight < a.weight)
+            {
+                a.weight = weight;
+                a.middle = middle;
+                for (workArc &b : in[w])
+                {
+                    if (b.other == u)
+                    {
+                        b.weight = weight;
+                        b.middle = middle;
+                    }
+                }
+            }
+            return;
+        }
+
+        workArc forward = {w, weight, middle};
+        workArc backward = {u, weight, middle};
+        out[u].push_back(forward);
+        in[w].push_back(backward);
+        liveArcs++;
+    }
+
+    void contractor::detach(int v)
+    {
+        liveArcs -= out[v].size() + in[v].size();
+        for (const workArc &a : out[v])
+        {
+            vector<workArc> &list = in[a.other];
+            for (size_t i = 0; i < list.size(); i++)
+            {
+                if (list[i].other == v)
+                {
+                    list[i] = list.back();
+                    list.pop_back();
+                    break;
+                }
+            }
+        }
+        for (const workArc &a : in[v])
+        {
+            vector<workArc> &list = out[a.other];
+            for (size_t i = 0; i < list.size(); i++)
+            {
+                if (list[i].other == v)
+                {
+                    list[i] = list.back();
+                    list.pop_back();
+                    break;
+                }
+            }
+        }
+    }
+
+    void contractor::witnessSearch(int source, int skip, long long limit)
+    {
+        if (++epoch == 0)
+        {
+            // The stamps wrapped around, so clear them.
+            fill(stamp.begin(), stamp.end(), 0);
+            fill(wanted.begin(), wanted.end(), 0);
+            epoch = 1;
+        }
+
+        int targets = 0;
+        for (const workArc &b : out[skip])
+        {
+            if (b.other != source && wanted[b.other] != epoch)
+            {
+                wanted[b.other] = epoch;
+                targets++;
+            }
+        }
+
+        witnessQueue.clear();
+        distance[source] = 0;
+        stamp[source] = epoch;
+        witnessQueue.insert(source, 0);
+
+        int settled = 0;
+        int u, key;
+        while (witnessQueue.deleteMin(&u, &key) == 0)
+        {
+            if (key > limit || ++settled > witnessSettleLimit)
+                break;
+            if (wanted[u] == epoch && --targets == 0)
+                break; // Every target's distance is final.
+
+            for (const workArc &a : out[u])
+            {
+                int v = a.other;
+                if (v == skip)
+                    continue;
+
+                long long d = static_cast<long long>(key) + a.weight;
+                if (d > limit)
+                    continue; // Too long to be a witness.
+                if (stamp[v] != epoch)
+                {
+                    stamp[v] = epoch;
+                    distance[v] = d;
+                    witnessQueue.insert(v, d);
+                }
+                else if (d < distance[v])
+                {
+                    distance[v] = d;
+                    witnessQueue.setKey(v, d);
+                }
+            }
+        }
+    }
+
+    int contractor::contract(int v, bool simulate)
+    {
+        int needed = 0;
+        for (size_t i = 0; i < in[v].size(); i++)
+        {
+            const workArc &a = in[v][i];
+            int u = a.other;
+
+            // The witness search only has to look as far as the longest path through v.
+            int longest = -1;
+            for (const workArc &b : out[v])
+            {
+                if (b.other != u)
+                    longest = max(longest, b.weight);
+            }
+            if (longest < 0)
+                continue;
+            witnessSearch(u, v, static_cast<long long>(a.weight) + longest);
+
+            for (const workArc &b : out[v])
+            {
+                int w = b.other;
+                long long through = static_cast<long long>(a.weight) + b.weight;
+                if (w == u || witnessDistance(w) <= through)
+                    continue;
+
+                needed++;
+                if (!simulate)
+                {
+                    addArc(u, w, static_cast<int>(min<long long>(through, INT32_MAX)), v);
+                    shortcuts++;
+                }
+            }
+        }
+        return needed;
+    }
+
+    int contractor::priority(int v)
+    {
+        int removed = in[v].size() + out[v].size();
+        return contract(v, true) - removed + deletedNeighbors[v];
+    }
+
+    void contractor::run()
+    {
+        int n = out.size();
+        vertexHeap order(n);
+        for (int v = 0; v < n; v++)
+            order.insert(v, priority(v));
+
+        int next = 0, remaining = n;
+        vector<int> neighbors;
+        int v, key, lowest;
+        while (order.deleteMin(&v, &key) == 0)
+        {
+            // Contracting a dense graph adds shortcuts between most pairs of neighbours, at a cost growing
+            // with the cube of the degree, so a dense remainder is left as a core searched as it is.
+            if (liveArcs > static_cast<long long>(coreDegree) * remaining)
+            {
+                order.insert(v, key);
+                break;
+            }
+
+            // Priorities go stale as neighbours are contracted; put v back if it is no longer the least important.
+            int current = priority(v);
+            if (order.peekMin(nullptr, &lowest) == 0 && current > lowest)
+            {
+                order.insert(v, current);
+                continue;
+            }
+
+            contract(v, false);
+            detach(v);
+            rank[v] = next++;
+            remaining--;
+
+            // Each neighbour has one more contracted neighbour and may need other shortcuts now.
+            neighbors.clear();
+            for (const workArc &a : in[v])
+                neighbors.push_back(a.other);
+            for (const workArc &a : out[v])
+                neighbors.push_back(a.other);
+            up[v].swap(out[v]);
+            down[v].swap(in[v]);
+            sort(neighbors.begin(), neighbors.end());
+            neighbors.erase(unique(neighbors.begin(), neighbors.end()), neighbors.end());
+            for (int w : neighbors)
+            {
+                deletedNeighbors[w]++;
+                order.setKey(w, priority(w));
+            }
+        }
+
+        // Core vertices rank above the rest, and keep their arcs in both directions: a query's upward
+        // searches go through the core as through an ordinary graph.
+        while (order.deleteMin(&v, &key) == 0)
+        {
+            rank[v] = next++;
+            up[v] = out[v];
+            down[v] = in[v];
+            core++;
+        }
+    }
+
+    // Writes a vector's elements.
+    template <typename T>
+    void writeArray(ofstream &out, const vector<T> &values)
+    {
+        out.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    // Reads n elements into a vector; returns false if the file ends first.
+    template <typename T>
+    bool readArray(ifstream &in, vector<T> &values, int64_t n)
+    {
+        values.resize(n);
+        in.read(reinterpret_cast<char *>(values.data()), n * sizeof(T));
+        return static_cast<bool>(in);
+    }
+
+    // Hashes the graph's adjacency (each vertex's edge count, then its targets and weights), so a
+    // hierarchy is only used with the very graph it was built from, not just one of the same size.
+    uint64_t graphFingerprint(const Graph &graph)
+    {
+        uint64_t h = 14695981039346656037ULL; // FNV-1a, a word at a time.
+        for (int v = 0; v < graph.vertexCount(); v++)
+        {
+            const int *targets, *weights;
+            int count = graph.outEdges(v, targets, weights);
+            h = (h ^ static_cast<uint32_t>(count)) * 1099511628211ULL;
+            for (int e = 0; e < count; e++)
+            {
+                h = (h ^ static_cast<uint32_t>(targets[e])) * 1099511628211ULL;
+                h = (h ^ static_cast<uint32_t>(weights[e])) * 1099511628211ULL;
+            }
+        }
+        return h;
+    }
+
+    // Checks that rank numbers the n vertices 0 to n - 1, each once.
+    bool validRank(const vector<int> &rank)
+    {
+        vector<char> seen(rank.size(), 0);
+        for (int r : rank)
+        {
+            if (r < 0 || r >= static_cast<int>(rank.size()) || seen[r])
+                return false;
+            seen[r] = 1;
+        }
+        return true;
+    }
+
+    // Checks that offsets into the arcs are in order, the arcs' vertices are in range, and every shortcut
+    // bypasses a vertex ranked below both its ends, so expanding shortcuts always comes to an end.
+    template <typename Arc>
+    bool validArcs(const vector<int> &start, const vector<Arc> &arcs, const vector<int> &rank)
+    {
+        int n = rank.size();
+        if (start.front() != 0 || start.back() != static_cast<int64_t>(arcs.size()))
+            return false;
+        for (int v = 0; v < n; v++)
+        {
+            if (start[v] > start[v + 1])
+                return false;
+        }
+        for (int v = 0; v < n; v++)
+        {
+            for (int e = start[v]; e < start[v + 1]; e++)
+            {
+                const Arc &a = arcs[e];
+                if (a.other < 0 || a.other >= n || a.other == v || a.middle < -1 || a.middle >= n)
+                    return false;
+                if (a.middle != -1 && (rank[a.middle] >= rank[v] || rank[a.middle] >= rank[a.other]))
+                    return false;
+            }
+        }
+        return true;
+    }
+}
+
+// Constructor for an empty hierarchy.
+contractionHierarchy::contractionHierarchy()
+    : shortcuts(0), core(0), graphEdges(0), graphHash(0)
+{
+}
+
+// Contracts the graph, then packs the arcs each vertex was left with when it was contracted.
+int contractionHierarchy::build(const Graph &graph)
+{
+    if (graph.smallestWeight() < 0)
+        return 1; // Shortcuts and witnesses assume non-negative weights.
+
+    contractor work(graph);
+    work.run();
+
+    int n = graph.vertexCount();
+    rank = work.rank;
+    shortcuts = work.shortcuts;
+    core = work.core;
+    graphEdges = graph.edgeCount();
+    graphHash = graphFingerprint(graph);
+
+    // Packs each vertex's upward and downward arcs into one array apiece.
+    upStart.assign(n + 1, 0);
+    downStart.assign(n + 1, 0);
+    for (int v = 0; v < n; v++)
+    {
+        upStart[v + 1] = upStart[v] + work.up[v].size();
+        downStart[v + 1] = downStart[v] + work.down[v].size();
+    }
+
+    up.clear();
+    down.clear();
+    up.reserve(upStart[n]);
+    down.reserve(downStart[n]);
+    for (int v = 0; v < n; v++)
+    {
+        for (const workArc &a : work.up[v])
+            up.push_back({a.other, a.weight, a.middle});
+        for (const workArc &a : work.down[v])
+            down.push_back({a.other, a.weight, a.middle});
+    }
+    return 0;
+}
+
+// Writes the header and the arrays.
+int contractionHierarchy::save(const string &fileName) const
+{
+    ofstream outFile(fileName, ios::binary);
+    if (!outFile.is_open())
+        return 1;
+
+    hierarchyHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, hierarchyMagic, sizeof(hierarchyMagic));
+    header.version = hierarchyVersion;
+    header.vertexCount = rank.size();
+    header.graphEdges = graphEdges;
+    header.graphHash = graphHash;
+    header.upCount = up.size();
+    header.downCount = down.size();
+    header.shortcuts = shortcuts;
+    header.core = core;
+    outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+    writeArray(outFile, rank);
+    writeArray(outFile, upStart);
+    writeArray(outFile, up);
+    writeArray(outFile, downStart);
+    writeArray(outFile, down);
+    outFile.close();
+    return outFile ? 0 : 1;
+}
+
+// Reads the arrays back and checks that they fit the graph.
+int contractionHierarchy::load(const string &fileName, const Graph &graph)
+{
+    ifstream inFile(fileName, ios::binary);
+    if (!inFile.is_open())
+        return 1;
+
+    hierarchyHeader header;
+    if (!inFile.read(reinterpret_cast<char *>(&header), sizeof(header)) ||
+        memcmp(header.magic, hierarchyMagic, sizeof(hierarchyMagic)) != 0 ||
+        header.version != hierarchyVersion || header.vertexCount != graph.vertexCount() ||
+        header.graphEdges != graph.edgeCount() || header.upCount < 0 || header.downCount < 0 ||
+        header.upCount > INT32_MAX || header.downCount > INT32_MAX || header.core < 0 || header.core > header.vertexCount)
+        return 2;
+
+    int n = header.vertexCount;
+    if (!readArray(inFile, rank, n) || !readArray(inFile, upStart, n + 1) || !readArray(inFile, up, header.upCount) ||
+        !readArray(inFile, downStart, n + 1) || !readArray(inFile, down, header.downCount) ||
+        !validRank(rank) || !validArcs(upStart, up, rank) || !validArcs(downStart, down, rank) ||
+        header.graphHash != graphFingerprint(graph))
+    {
+        rank.clear();
+        return 2;
+    }
+    shortcuts = header.shortcuts;
+    core = header.core;
+    graphEdges = header.graphEdges;
+    graphHash = header.graphHash;
+    return 0;
+}
+
+// Returns the bytes of the rank, offset and arc arrays.
+size_t contractionHierarchy::memoryBytes() const
+{
+    return (rank.size() + upStart.size() + downStart.size()) * sizeof(int) + (up.size() + down.size()) * sizeof(arc);
+}
+
+// Answers in two phases. First each side climbs the contracted vertices, stopping at the core vertices
+// it reaches; a side stops once its smallest queued distance is at least the best meeting found, since
+// every vertex it could still settle is too far. Then both sides continue from those core vertices with
+// bidirectional Dijkstra, which stops once the two smallest queued distances add up to the best meeting:
+// inside the core, stopping each side on its own would have both search a ball of that radius.
+// A meeting is recorded whenever a side lowers the distance of a vertex the other side has reached.
+int contractionHierarchy::query(int source, int target, Graph::pathState &state, vector<int> *path) const
+{
+    if (path)
+        path->clear();
+    int n = rank.size();
+    if (source < 0 || source >= n || target < 0 || target >= n)
+        return -1;
+
+    Graph::searchState *sides[2] = {&state.forward, &state.backward};
+    const vector<int> *starts[2] = {&upStart, &downStart};
+    const vector<arc> *arcs[2] = {&up, &down};
+    int origins[2] = {source, target};
+    int coreStart = n - core; // Rank of the least important core vertex.
+    vector<int> entrances[2]; // Core vertices each side reached while climbing.
+
+    long long best = INT32_MAX;
+    int meet = -1;
+    auto meetAt = [&](int v, int distance, const Graph::searchState &there)
+    {
+        if (there.reached(v) && distance + static_cast<long long>(there.entries[v].distance) < best)
+        {
+            best = distance + static_cast<long long>(there.entries[v].distance);
+            meet = v;
+        }
+    };
+
+    sides[0]->begin(n);
+    sides[1]->begin(n);
+    for (int side = 0; side < 2; side++)
+    {
+        Graph::searchState &here = *sides[side];
+        const Graph::searchState &there = *sides[1 - side];
+        Graph::searchState::entry *entries = here.entries.data();
+        const uint32_t reached = here.epoch, settled = here.epoch + 1;
+        entries[origins[side]] = {0, -1, reached};
+        meetAt(origins[side], 0, there);
+
+        radixHeap queue(n);
+        if (rank[origins[side]] >= coreStart)
+            entrances[side].push_back(origins[side]);
+        else
+            queue.insert(0, origins[side]);
+
+        int u, key;
+        while (queue.deleteMin(&key, &u) == 0 && key < best)
+        {
+            if (entries[u].stamp == settled)
+                continue; // Skips stale entries.
+            entries[u].stamp = settled;
+            here.settled++;
+
+            // Stall on demand: a more important vertex reached with a shorter way into u shows that key is
+            // not u's distance, so no shortest path climbs on from u and its arcs are not relaxed.
+            const vector<int> &intoStart = *starts[1 - side];
+            const vector<arc> &into = *arcs[1 - side];
+            bool stalled = false;
+            for (int e = intoStart[u]; e < intoStart[u + 1] && !stalled; e++)
+            {
+                const Graph::searchState::entry &ew = entries[into[e].other];
+                stalled = ew.stamp >= reached && static_cast<long long>(ew.distance) + into[e].weight < key;
+            }
+            if (stalled)
+                continue;
+
+            for (int e = (*starts[side])[u]; e < (*starts[side])[u + 1]; e++)
+            {
+                const arc &a = (*arcs[side])[e];
+                int newDist = key + a.weight;
+                Graph::searchState::entry &ev = entries[a.other];
+                if (ev.stamp < reached || (ev.stamp == reached && newDist < ev.distance))
+                {
+                    // Core vertices wait for the second phase, queued with their lowest distance from this one.
+                    if (rank[a.other] >= coreStart && ev.stamp < reached)
+                        entrances[side].push_back(a.other);
+                    else if (rank[a.other] < coreStart)
+                        queue.insert(newDist, a.other);
+                    ev.distance = newDist;
+                    ev.previous = u;
+                    ev.stamp = reached;
+                    meetAt(a.other, newDist, there);
+                }
+            }
+        }
+    }
+
+    // Each side keeps its next vertex out of its queue, so the two smallest distances can be compared.
+    radixHeap queues[2] = {radixHeap(n), radixHeap(n)};
+    int heads[2], headKeys[2];
+    bool more[2];
+    auto nextHead = [&](int side)
+    {
+        const Graph::searchState &here = *sides[side];
+        while (queues[side].deleteMin(&headKeys[side], &heads[side]) == 0)
+        {
+            if (here.entries[heads[side]].stamp != here.epoch + 1)
+                return true;
+        }
+        return false;
+    };
+    for (int side = 0; side < 2; side++)
+    {
+        for (int v : entrances[side])
+            queues[side].insert(sides[side]->entries[v].distance, v);
+        more[side] = nextHead(side);
+    }
+
+    while (more[0] && more[1] && static_cast<long long>(headKeys[0]) + headKeys[1] < best)
+    {
+        int side = headKeys[0] <= headKeys[1] ? 0 : 1;
+        Graph::searchState &here = *sides[side];
+        const Graph::searchState &there = *sides[1 - side];
+        Graph::searchState::entry *entries = here.entries.data();
+        const uint32_t reached = here.epoch, settled = here.epoch + 1;
+        int u = heads[side], key = headKeys[side];
+        entries[u].stamp = settled;
+        here.settled++;
+
+        for (int e = (*starts[side])[u]; e < (*starts[side])[u + 1]; e++)
+        {
+            const arc &a = (*arcs[side])[e];
+            int newDist = key + a.weight;
+            Graph::searchState::entry &ev = entries[a.other];
+            if (ev.stamp < reached || (ev.stamp == reached && newDist < ev.distance))
+            {
+                ev.distance = newDist;
+                ev.previous = u;
+                ev.stamp = reached;
+                queues[side].insert(newDist, a.other);
+                meetAt(a.other, newDist, there);
+            }
+        }
+        more[side] = nextHead(side);
+    }
+
+    if (meet == -1)
+        return INT32_MAX;
+
+    if (path)
+    {
+        // Climbs from the source to the meeting vertex, then down to the target, expanding shortcuts.
+        vector<int> climb;
+        for (int v = meet; v != -1; v = state.forward.previous(v))
+            climb.push_back(v);
+        reverse(climb.begin(), climb.end());
+        for (int v = state.backward.previous(meet); v != -1; v = state.backward.previous(v))
+            climb.push_back(v);
+
+        path->push_back(source);
+        for (size_t i = 1; i < climb.size(); i++)
+            unpack(climb[i - 1], climb[i], *path);
+    }
+    return best;
+}
+
+// Upward arcs are stored with their tail, downward ones with their head.
+const contractionHierarchy::arc *contractionHierarchy::findArc(int a, int b) const
+{
+    if (rank[a] < rank[b])
+    {
+        for (int e = upStart[a]; e < upStart[a + 1]; e++)
+        {
+            if (up[e].other == b)
+                return &up[e];
+        }
+    }
+    else
+    {
+        for (int e = downStart[b]; e < downStart[b + 1]; e++)
+        {
+            if (down[e].other == a)
+                return &down[e];
+        }
+    }
+    return nullptr;
+}
+
+// Expands shortcuts with a stack, so long chains of shortcuts cannot overflow the call stack.
+void contractionHierarchy::unpack(int a, int b, vector<int> &path) const
+{
+    vector<pair<int, int>> pending(1, make_pair(a, b));
+    while (!pending.empty())
+    {
+        pair<int, int> step = pending.back();
+        pending.pop_back();
+        const arc *pa = findArc(step.first, step.second);
+        if (pa == nullptr || pa->middle == -1)
+        {
+            path.push_back(step.second);
+            continue;
+        }
+        pending.push_back(make_pair(pa->middle, step.second)); // Second half, done after the first.
+        pending.push_back(make_pair(step.first, pa->middle));
+    }
+}
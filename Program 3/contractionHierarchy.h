@@ -0,0 +1,86 @@
+#ifndef _CONTRACTIONHIERARCHY_H
+#define _CONTRACTIONHIERARCHY_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "graph.h"
+#include "vertexHeap.h"
+
+using namespace std;
+
+// Contraction hierarchies for fast point-to-point queries on a graph with non-negative weights.
+// Preprocessing contracts the vertices one at a time, least important first: a vertex is taken out
+// of the graph, and a shortcut edge u -> w is added for each pair of its neighbours whose shortest
+// path went through it, unless a local witness search finds another path that is no longer. A
+// vertex's importance is its edge difference (shortcuts needed minus edges removed) plus the number of
+// neighbours already contracted, kept up to date lazily. A query then only climbs: a search forward
+// from the source and one backward from the target, each following edges to more important vertices,
+// meet at the most important vertex of a shortest path, so each settles a few hundred vertices.
+// Graphs without much hierarchy (random graphs, say) grow dense as they are contracted; contraction
+// stops there, and the remaining core keeps its edges both ways; queries climb into it from both ends
+// and finish with bidirectional Dijkstra inside it.
+// The hierarchy refers to the graph's vertex numbers, and can be saved once and loaded for each run.
+class contractionHierarchy
+{
+public:
+    // Constructor: Makes an empty hierarchy; build or load fills it in.
+    contractionHierarchy();
+
+    // Contracts the vertices of the graph, leaving a dense remainder as the core.
+    // Returns 0 on success, 1 if the graph has negative weights.
+    int build(const Graph &graph);
+
+    // Writes the hierarchy to a file.
+    // Returns 0 on success, 1 if the file could not be written.
+    int save(const string &fileName) const;
+
+    // Reads a hierarchy written by save for the given graph.
+    // Returns 0 on success, 1 if the file could not be read, 2 if it is damaged or was built for another graph.
+    int load(const string &fileName, const Graph &graph);
+
+    // Finds the distance from source to target with an upward search from each end, continued through
+    // the core with bidirectional Dijkstra; path, if given, receives the vertex numbers from source to
+    // target with every shortcut expanded, or is left empty.
+    // Returns the distance, INT32_MAX if target cannot be reached, or -1 if a vertex is out of range.
+    int query(int source, int target, Graph::pathState &state, vector<int> *path = nullptr) const;
+
+    // Returns the number of vertices, or 0 before build or load.
+    int size() const { return rank.size(); }
+
+    // Returns the number of shortcut edges added by contraction.
+    int shortcutCount() const { return shortcuts; }
+
+    // Returns the number of vertices left uncontracted in the core.
+    int coreSize() const { return core; }
+
+    // Returns the bytes taken by the hierarchy's arrays.
+    size_t memoryBytes() const;
+
+private:
+    // An edge of the hierarchy; middle is the contracted vertex a shortcut bypasses, or -1 for a graph edge.
+    struct arc
+    {
+        int other;  // The vertex at the other end.
+        int weight; // Length of the edge.
+        int middle; // Vertex the shortcut bypasses, or -1.
+    };
+
+    vector<int> rank;      // Contraction order of each vertex; higher is more important.
+    vector<int> upStart;   // Edges from v to more important vertices are up[upStart[v]] to up[upStart[v + 1] - 1].
+    vector<arc> up;
+    vector<int> downStart; // Edges into v from more important vertices, with other the source, likewise.
+    vector<arc> down;
+    int shortcuts;         // Number of shortcuts among the arcs.
+    int core;              // Number of core vertices, the most important ones, whose arcs are in both lists.
+    int64_t graphEdges;    // Edge count of the graph it was built for, checked by load.
+    uint64_t graphHash;    // Fingerprint of that graph's edges, checked by load.
+
+    // Finds the arc from a to b (a shortcut or an edge) stored in the up or down lists.
+    const arc *findArc(int a, int b) const;
+
+    // Appends the vertices after a on the path a -> b, expanding shortcuts.
+    void unpack(int a, int b, vector<int> &path) const;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*
+   Name: Talha Akhlaq
+   Description: Times Dijkstra's algorithm on a graph file with each priority queue (binary heap,
+   pairing heap, vertex heap, radix heap and Dial's bucket queue) and checks that all give the same distances.
+   Usage: dijkstraBench.exe <graph file> <starting vertex> [runs]
+*/
+
+#include "graph.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace std::chrono;
+
+// Runs Dijkstra's algorithm the given number of times and returns the fastest run in seconds.
+template <typename PriorityQueue>
+double timeDijkstra(Graph &g, const string &startVertex, int runs)
+{
+  double best = 0;
+  for (int i = 0; i < runs; ++i)
+  {
+    auto startTime = steady_clock::now();
+    g.dijkstra<PriorityQueue>(startVertex);
+    double elapsed = duration_cast<duration<double>>(steady_clock::now() - startTime).count();
+    if (i == 0 || elapsed < best)
+    {
+      best = elapsed;
+    }
+  }
+  return best;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc < 3)
+  {
+    cerr << "Usage: " << argv[0] << " <graph file> <starting vertex> [runs]" << endl;
+    return 1;
+  }
+
+  string startVertex = argv[2];
+  int runs = (argc > 3) ? atoi(argv[3]) : 5;
+  if (runs < 1)
+  {
+    cerr << "Error: The number of runs must be positive." << endl;
+    return 1;
+  }
+
+  auto loadStart = steady_clock::now();
+  Graph g(argv[1]);
+  double loadTime = duration_cast<duration<double>>(steady_clock::now() - loadStart).count();
+  if (!g.isValidVertex(startVertex))
+  {
+    cerr << "Error: Starting vertex '" << startVertex << "' not found in graph." << endl;
+    return 1;
+  }
+
+  const int queues = 5;
+  const char *names[queues] = {"binary heap", "pairing heap", "vertex heap", "radix heap", "bucket queue"};
+  double times[queues];
+  vector<int> distances[queues];
+
+  times[0] = timeDijkstra<heap>(g, startVertex, runs);
+  g.distances(distances[0]);
+  times[1] = timeDijkstra<pairingHeap>(g, startVertex, runs);
+  g.distances(distances[1]);
+  times[2] = timeDijkstra<vertexHeap>(g, startVertex, runs);
+  g.distances(distances[2]);
+  times[3] = timeDijkstra<radixHeap>(g, startVertex, runs);
+  g.distances(distances[3]);
+  times[4] = timeDijkstra<bucketQueue>(g, startVertex, runs);
+  g.distances(distances[4]);
+
+  cout << fixed << setprecision(6);
+  cout << g.vertexCount() << " vertices, " << g.edgeCount() << " edges, loaded in " << loadTime << " seconds" << endl;
+  cout << "Best of " << runs << " runs (in seconds):" << endl;
+  for (int q = 0; q < queues; ++q)
+  {
+    cout << left << setw(16) << names[q] << right << setw(12) << times[q] << endl;
+  }
+
+  for (int q = 1; q < queues; ++q)
+  {
+    if (distances[q] != distances[0])
+    {
+      cerr << "Error: The " << names[q] << " produced different distances from the binary heap." << endl;
+      return 1;
+    }
+  }
+  return 0;
+}
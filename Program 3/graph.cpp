@@ -1,164 +1,1199 @@
 /* Name: Talha Akhlaq
-   Description: Constructs a graph from an input file using a hash table and adjacency lists,
-   applies Dijkstra's algorithm with a binary heap for shortest path calculation, and outputs results to a file.
+   Description: Constructs a graph from an input file, parsed in parallel from a memory mapping or used
+   in place from a binary graph file, with a name table and a compressed sparse row adjacency (one offsets
+   array and contiguous edge arrays, with vertices numbered densely), applies Dijkstra's algorithm for
+   shortest path calculation, and outputs results to a file.
 */
 
 #include "graph.h"
 #include <iostream>
 #include <fstream>
 #include <stack>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <atomic>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 using namespace std;
 
-// Deallocates memory for dynamically created Vertex objects.
-Graph::~Graph()
+namespace
 {
-  for (auto &v : vertexList)
+  // The queues carry a data pointer per entry; the graph stores a vertex number in it.
+  void *toData(int v)
+  {
+    return reinterpret_cast<void *>(static_cast<intptr_t>(v));
+  }
+
+  int toVertex(void *pv)
+  {
+    return static_cast<int>(reinterpret_cast<intptr_t>(pv));
+  }
+
+  // The edges of one slice of the input file, with vertices numbered within the slice.
+  struct slice
+  {
+    nameTable names;         // Vertex names in order of first appearance in the slice.
+    vector<int> edges;       // Source, destination and weight of each edge, three ints per edge.
+    bool stopped = false;    // Set if the slice ends at a token that is not part of an edge.
+    int minWeight = INT_MAX; // Weight range of the slice's edges.
+    int maxWeight = 0;
+  };
+
+  bool isSpace(char c)
+  {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+  }
+
+  // Finds the next whitespace-separated token; returns false at the end of the slice.
+  bool nextToken(const char *&p, const char *end, const char *&tokenStart, size_t &length)
+  {
+    while (p < end && isSpace(*p))
+    {
+      p++;
+    }
+    tokenStart = p;
+    while (p < end && !isSpace(*p))
+    {
+      p++;
+    }
+    length = p - tokenStart;
+    return length > 0;
+  }
+
+  // Reads a whole token as a decimal integer with an optional sign, without locales or allocation.
+  bool parseInt(const char *p, size_t length, int &value)
+  {
+    bool negative = (*p == '-');
+    if (*p == '-' || *p == '+')
+    {
+      p++;
+      length--;
+    }
+    if (length == 0 || length > 10)
+    {
+      return false;
+    }
+
+    long long result = 0;
+    for (size_t i = 0; i < length; ++i)
+    {
+      unsigned int digit = static_cast<unsigned char>(p[i]) - '0';
+      if (digit > 9)
+      {
+        return false;
+      }
+      result = result * 10 + digit;
+    }
+    result = negative ? -result : result;
+    if (result < INT_MIN || result > INT_MAX)
+    {
+      return false;
+    }
+    value = static_cast<int>(result);
+    return true;
+  }
+
+  // Parses the edges of one slice of the file, numbering its vertex names locally.
+  // Edges are taken in groups: all names of a group are hashed and their table slots
+  // prefetched first, so the cache misses of the lookups overlap instead of queueing.
+  void parseSlice(const char *begin, const char *end, slice &s)
   {
-    delete v;
+    const int group = 32;
+    const char *name[2 * group];
+    size_t length[2 * group];
+    uint64_t hash[2 * group];
+    int weight[group];
+
+    const char *p = begin;
+    for (;;)
+    {
+      int edges = 0;
+      int tokens = 0;
+      const char *weightToken;
+      size_t weightLength;
+      while (edges < group)
+      {
+        tokens = 0;
+        while (tokens < 2 && nextToken(p, end, name[2 * edges + tokens], length[2 * edges + tokens]))
+        {
+          tokens++;
+        }
+        if (tokens == 2 && nextToken(p, end, weightToken, weightLength))
+        {
+          tokens++;
+        }
+
+        // Like reading with >>, loading ends at the first incomplete or malformed edge.
+        if (tokens < 3 || !parseInt(weightToken, weightLength, weight[edges]))
+        {
+          s.stopped = (tokens > 0);
+          break;
+        }
+        for (int i = 2 * edges; i < 2 * edges + 2; ++i)
+        {
+          hash[i] = nameTable::hash(name[i], length[i]);
+          s.names.prefetch(hash[i]);
+        }
+        edges++;
+      }
+
+      for (int e = 0; e < edges; ++e)
+      {
+        s.edges.push_back(s.names.intern(name[2 * e], length[2 * e], hash[2 * e]));
+        s.edges.push_back(s.names.intern(name[2 * e + 1], length[2 * e + 1], hash[2 * e + 1]));
+        s.edges.push_back(weight[e]);
+        s.minWeight = min(s.minWeight, weight[e]);
+        s.maxWeight = max(s.maxWeight, weight[e]);
+      }
+      if (edges < group)
+      {
+        return;
+      }
+    }
   }
 }
 
 // Constructor to initialize graph structure from input file.
 Graph::Graph(const string &input_file)
-    : vertices(100000) // Sets initial hash table size.
+    : names(100000), // Sets initial name table size.
+      minWeight(INT_MAX), maxWeight(0), edges(0), mapped(nullptr), mappedSize(0)
 {
   loadGraph(input_file);
 }
 
+// Releases the mapping of a binary graph file.
+Graph::~Graph()
+{
+  if (mapped)
+  {
+    munmap(mapped, mappedSize);
+  }
+}
+
+namespace
+{
+  // Identifies a binary graph file; the version changes whenever the layout does.
+  const char graphMagic[8] = {'D', 'J', 'K', 'G', 'R', 'A', 'P', 'H'};
+  const uint32_t graphVersion = 2;
+
+  // Header of a binary graph file. The edge offsets, destinations and weights follow as ints,
+  // then the same three arrays for the reverse graph, each array padded to a multiple of 8 bytes,
+  // and then the name table's arrays. Version 1 files lacked the reverse arrays.
+  struct graphHeader
+  {
+    char magic[8];       // graphMagic.
+    uint32_t version;    // graphVersion, which also tells a file written with the other byte order.
+    int32_t vertexCount; // Number of vertices.
+    int64_t edgeCount;   // Number of edges.
+    int32_t minWeight;   // Smallest edge weight.
+    int32_t maxWeight;   // Largest edge weight.
+  };
+
+  // Bytes taken by an array of n ints once padded to a multiple of 8.
+  size_t paddedInts(size_t n)
+  {
+    return (n * sizeof(int) + 7) / 8 * 8;
+  }
+
+  // Writes an array of ints with its padding.
+  void writeInts(ofstream &out, const int *values, size_t n)
+  {
+    const char zeros[8] = {0};
+    out.write(reinterpret_cast<const char *>(values), n * sizeof(int));
+    out.write(zeros, paddedInts(n) - n * sizeof(int));
+  }
+
+  // Checks one direction of a mapped adjacency: offsets start at 0, never decrease and end at the edge
+  // count, the other ends are vertices, and weights lie within the bounds the header records.
+  bool validAdjacency(const int *start, const int *other, const int *weight, int n, int m, int minWeight, int maxWeight)
+  {
+    if (start[0] != 0 || start[n] != m)
+    {
+      return false;
+    }
+    for (int v = 0; v < n; ++v)
+    {
+      if (start[v] > start[v + 1])
+      {
+        return false;
+      }
+    }
+    for (int e = 0; e < m; ++e)
+    {
+      if (other[e] < 0 || other[e] >= n || weight[e] < minWeight || weight[e] > maxWeight)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+}
+
 // Reads vertices and edges from file, constructing graph structure.
+// A binary graph file stays mapped and is used in place; a text file is parsed and unmapped.
 void Graph::loadGraph(const string &fileName)
 {
-  ifstream inputFile(fileName);
-  if (!inputFile.is_open())
+  int fd = open(fileName.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || fstat(fd, &info) != 0)
   {
     cerr << "Error: Could not open file " << fileName << endl;
     exit(EXIT_FAILURE);
   }
 
-  string vertex1, vertex2;
-  int weight;
+  size_t size = info.st_size;
+  if (size == 0)
+  {
+    close(fd);
+    buildAdjacency(vector<Edge>());
+    return;
+  }
+
+  // A shared read-only mapping lets every process using the same binary file share its pages.
+  void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    cerr << "Error: Could not map file " << fileName << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  if (attachGraph(static_cast<const char *>(data), size, fileName))
+  {
+    mapped = data;
+    mappedSize = size;
+    return;
+  }
+
+  madvise(data, size, MADV_SEQUENTIAL);
+  parseGraph(static_cast<const char *>(data), size);
+  munmap(data, size);
+}
+
+// Parses the edge list: the text is split at line boundaries across threads; each thread parses its
+// slice and numbers the names it meets, and the slices' names are then numbered globally in file order,
+// so vertices get the same numbers as when the file is read line by line.
+void Graph::parseGraph(const char *text, size_t size)
+{
+  // Small files are not worth the thread start-up; give each thread at least 1 MB.
+  size_t hardware = max(1u, thread::hardware_concurrency());
+  int threads = static_cast<int>(min(hardware, size / (1 << 20) + 1));
+
+  // Slice boundaries, each moved forward to the start of a line.
+  vector<const char *> bounds(threads + 1);
+  bounds[0] = text;
+  bounds[threads] = text + size;
+  for (int t = 1; t < threads; ++t)
+  {
+    const char *guess = max(bounds[t - 1], text + size / threads * t);
+    const char *newline = static_cast<const char *>(memchr(guess, '\n', text + size - guess));
+    bounds[t] = newline ? newline + 1 : text + size;
+  }
+
+  vector<slice> slices(threads);
+  vector<thread> pool;
+  for (int t = 1; t < threads; ++t)
+  {
+    pool.emplace_back(parseSlice, bounds[t], bounds[t + 1], ref(slices[t]));
+  }
+  parseSlice(bounds[0], bounds[1], slices[0]);
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+
+  // Numbers each slice's names globally, in file order, up to the first slice that stopped early.
+  int used = 0;
+  vector<vector<int>> numbers(threads);
+  vector<size_t> firstEdge(threads + 1, 0);
+  while (used < threads)
+  {
+    slice &s = slices[used];
+    for (int v = 0; v < s.names.size(); ++v)
+    {
+      numbers[used].push_back(names.intern(s.names.data(v), s.names.length(v)));
+    }
+    minWeight = min(minWeight, s.minWeight);
+    maxWeight = max(maxWeight, s.maxWeight);
+    firstEdge[used + 1] = firstEdge[used] + s.edges.size() / 3;
+    used++;
+    if (s.stopped)
+    {
+      break;
+    }
+  }
+
+  // Renumbers every slice's edges into one list, each slice on its own thread.
+  vector<Edge> edgeList(firstEdge[used]);
+  auto renumber = [&](int t)
+  {
+    const vector<int> &local = slices[t].edges;
+    for (size_t i = 0, e = firstEdge[t]; i < local.size(); i += 3, ++e)
+    {
+      edgeList[e] = {numbers[t][local[i]], numbers[t][local[i + 1]], local[i + 2]};
+    }
+    vector<int>().swap(slices[t].edges);
+  };
+  pool.clear();
+  for (int t = 1; t < used; ++t)
+  {
+    pool.emplace_back(renumber, t);
+  }
+  renumber(0);
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
 
-  // Parses each line to retrieve vertex pairs and edge weights.
-  while (inputFile >> vertex1 >> vertex2 >> weight)
+  buildAdjacency(edgeList);
+}
+
+// Counting sort of the edges by source vertex, keeping each vertex's edges in file order.
+void Graph::buildAdjacency(const vector<Edge> &edgeList)
+{
+  int n = names.size();
+  startStore.assign(n + 1, 0);
+  for (const Edge &e : edgeList)
   {
-    insertEdge(vertex1, vertex2, weight);
+    startStore[e.source + 1]++;
   }
-  inputFile.close();
+  for (int v = 0; v < n; ++v)
+  {
+    startStore[v + 1] += startStore[v];
+  }
+
+  targetStore.resize(edgeList.size());
+  weightStore.resize(edgeList.size());
+  vector<int> next(startStore.begin(), startStore.end() - 1); // Next free slot of each vertex.
+  for (const Edge &e : edgeList)
+  {
+    int slot = next[e.source]++;
+    targetStore[slot] = e.target;
+    weightStore[slot] = e.weight;
+  }
+
+  edges = edgeList.size();
+  edgeStart = startStore.data();
+  edgeTarget = targetStore.data();
+  edgeWeight = weightStore.data();
+  buildReverse();
 }
 
-// Adds directed edge from source to destination with weight.
-void Graph::insertEdge(const string &sourceId, const string &destId, int weight)
+// Counting sort of the forward edges by destination, so each vertex's incoming edges are contiguous.
+void Graph::buildReverse()
 {
-  Vertex *v1 = getOrCreateVertex(sourceId); // Finds or creates source vertex.
-  Vertex *v2 = getOrCreateVertex(destId);   // Finds or creates destination vertex.
+  int n = names.size();
+  reverseStartStore.assign(n + 1, 0);
+  for (int e = 0; e < edges; ++e)
+  {
+    reverseStartStore[edgeTarget[e] + 1]++;
+  }
+  for (int v = 0; v < n; ++v)
+  {
+    reverseStartStore[v + 1] += reverseStartStore[v];
+  }
 
-  // Connects v1 to v2 with specified weight.
-  Edge newEdge = {v2, weight};
-  v1->adjList.push_back(newEdge);
+  reverseSourceStore.resize(edges);
+  reverseWeightStore.resize(edges);
+  vector<int> next(reverseStartStore.begin(), reverseStartStore.end() - 1);
+  for (int u = 0; u < n; ++u)
+  {
+    for (int e = edgeStart[u]; e < edgeStart[u + 1]; ++e)
+    {
+      int slot = next[edgeTarget[e]]++;
+      reverseSourceStore[slot] = u;
+      reverseWeightStore[slot] = edgeWeight[e];
+    }
+  }
+
+  reverseStart = reverseStartStore.data();
+  reverseSource = reverseSourceStore.data();
+  reverseWeight = reverseWeightStore.data();
 }
 
-// Retrieves existing vertex or creates a new one if not found.
-Graph::Vertex *Graph::getOrCreateVertex(const string &name)
+// Checks the header and sizes of a binary graph file and points the graph's arrays into it.
+bool Graph::attachGraph(const char *data, size_t size, const string &fileName)
 {
-  bool found = false;
-  Vertex *v = static_cast<Vertex *>(vertices.getPointer(name, &found));
-  if (!found)
+  graphHeader header;
+  if (size < sizeof(header) || memcmp(data, graphMagic, sizeof(graphMagic)) != 0)
+  {
+    return false;
+  }
+  memcpy(&header, data, sizeof(header));
+  if (header.version != graphVersion)
   {
-    // Inserts new vertex in hash table and stores it in vertex list.
-    v = new Vertex(name);     // Create new vertex.
-    vertices.insert(name, v); // Add vertex to hash table.
-    vertexList.push_back(v);  // Store vertex in list.
+    cerr << "Error: " << fileName << " is a binary graph file of an unsupported version" << endl;
+    exit(EXIT_FAILURE);
   }
-  return v;
+
+  const char *end = data + size;
+  const char *p = data + sizeof(header);
+  size_t arrays = 2 * (paddedInts(header.vertexCount + 1) + 2 * paddedInts(header.edgeCount));
+  if (header.vertexCount < 0 || header.edgeCount < 0 || header.edgeCount > INT_MAX ||
+      static_cast<size_t>(end - p) < arrays ||
+      !names.attach(p + arrays, end) || names.size() != header.vertexCount)
+  {
+    cerr << "Error: Binary graph file " << fileName << " is truncated or damaged" << endl;
+    exit(EXIT_FAILURE);
+  }
+
+  edges = header.edgeCount;
+  minWeight = header.minWeight;
+  maxWeight = header.maxWeight;
+  const int *arrayStart[6];
+  size_t sizes[6] = {static_cast<size_t>(header.vertexCount) + 1, static_cast<size_t>(edges), static_cast<size_t>(edges)};
+  sizes[3] = sizes[0];
+  sizes[4] = sizes[5] = sizes[1];
+  for (int i = 0; i < 6; ++i)
+  {
+    arrayStart[i] = reinterpret_cast<const int *>(p);
+    p += paddedInts(sizes[i]);
+  }
+  edgeStart = arrayStart[0];
+  edgeTarget = arrayStart[1];
+  edgeWeight = arrayStart[2];
+  reverseStart = arrayStart[3];
+  reverseSource = arrayStart[4];
+  reverseWeight = arrayStart[5];
+
+  // A pass over the arrays costs far less than parsing, and keeps a damaged file from sending a search out of bounds.
+  int n = header.vertexCount;
+  if (!validAdjacency(edgeStart, edgeTarget, edgeWeight, n, edges, minWeight, maxWeight) ||
+      !validAdjacency(reverseStart, reverseSource, reverseWeight, n, edges, minWeight, maxWeight))
+  {
+    cerr << "Error: Binary graph file " << fileName << " is truncated or damaged" << endl;
+    exit(EXIT_FAILURE);
+  }
+  return true;
+}
+
+// Writes the header, the adjacency arrays and the name table.
+int Graph::save(const string &binaryFile) const
+{
+  ofstream outFile(binaryFile, ios::binary);
+  if (!outFile.is_open())
+  {
+    return 1;
+  }
+
+  graphHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, graphMagic, sizeof(graphMagic));
+  header.version = graphVersion;
+  header.vertexCount = names.size();
+  header.edgeCount = edges;
+  header.minWeight = minWeight;
+  header.maxWeight = maxWeight;
+  outFile.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  writeInts(outFile, edgeStart, names.size() + 1);
+  writeInts(outFile, edgeTarget, edges);
+  writeInts(outFile, edgeWeight, edges);
+  writeInts(outFile, reverseStart, names.size() + 1);
+  writeInts(outFile, reverseSource, edges);
+  writeInts(outFile, reverseWeight, edges);
+  names.write(outFile);
+
+  outFile.close();
+  return outFile ? 0 : 1;
 }
 
 // Checks if vertex exists within the graph.
 bool Graph::isValidVertex(const string &vertexId) const
 {
-  return vertices.contains(vertexId);
+  return names.find(vertexId) != -1;
+}
+
+// Largest edge weight for which Dial's bucket queue is chosen; beyond it the cursor
+// walks over too many empty buckets and the radix heap does better.
+const int maxDialWeight = 1000;
+
+// Executes Dijkstra's algorithm with the queue that suits the weights seen in loadGraph.
+void Graph::dijkstra(const string &startVertex)
+{
+  int source = names.find(startVertex);
+  if (source == -1)
+  {
+    cerr << "Error: Starting vertex '" << startVertex << "' not found in graph." << endl;
+    return;
+  }
+  search(source, -1, last);
+}
+
+// Searches with the queue that suits the weights seen in loadGraph.
+int Graph::search(int source, int target, searchState &state, bool backward) const
+{
+  if (minWeight < 0)
+  {
+    // Negative weights break the monotone queues' assumption; a heap with decrease-key still gives an answer.
+    return search<vertexHeap>(source, target, state, backward);
+  }
+  else if (maxWeight <= maxDialWeight)
+  {
+    return search<bucketQueue>(source, target, state, backward);
+  }
+  else
+  {
+    return search<radixHeap>(source, target, state, backward);
+  }
+}
+
+namespace
+{
+  // Queues a vertex in a heap that tracks string ids, lowering its key if it is already queued.
+  // These heaps hash the vertex's name on every call; they are kept to compare against.
+  template <typename PriorityQueue>
+  int pushVertex(PriorityQueue &q, const nameTable &names, int v, int key)
+  {
+    string id = names.name(v);
+    int status = q.insert(id, key, toData(v));
+    return (status == 2) ? q.setKey(id, key) : status;
+  }
+
+  // The vertex heap is indexed by vertex number directly.
+  int pushVertex(vertexHeap &q, const nameTable &, int v, int key)
+  {
+    int status = q.insert(v, key);
+    return (status == 2) ? q.setKey(v, key) : status;
+  }
+
+  // Monotone queues just take another entry; the old one is skipped once the vertex is known.
+  int pushVertex(radixHeap &q, const nameTable &, int v, int key)
+  {
+    return q.insert(key, v);
+  }
+
+  int pushVertex(bucketQueue &q, const nameTable &, int v, int key)
+  {
+    return q.insert(key, v);
+  }
+
+  // Takes the vertex with the smallest distance, and that distance, from a heap that tracks string ids.
+  template <typename PriorityQueue>
+  int popVertex(PriorityQueue &q, int &v, int &key)
+  {
+    void *pv = nullptr;
+    int status = q.deleteMin(nullptr, &key, &pv);
+    v = toVertex(pv);
+    return status;
+  }
+
+  int popVertex(vertexHeap &q, int &v, int &key)
+  {
+    return q.deleteMin(&v, &key);
+  }
+
+  int popVertex(radixHeap &q, int &v, int &key)
+  {
+    return q.deleteMin(&key, &v);
+  }
+
+  int popVertex(bucketQueue &q, int &v, int &key)
+  {
+    return q.deleteMin(&key, &v);
+  }
+
+  // Starting capacity of the queues that grow as needed.
+  const int initialQueueCapacity = 64;
+
+  // The queue for one search. Building a vertex heap touches every vertex, so the one kept in the
+  // search state is cleared and reused; the other queues start small and grow with what is reached.
+  template <typename PriorityQueue>
+  class searchQueue
+  {
+  public:
+    searchQueue(vertexHeap &, int)
+        : q(initialQueueCapacity)
+    {
+    }
+
+    PriorityQueue &get() { return q; }
+
+  private:
+    PriorityQueue q;
+  };
+
+  template <>
+  class searchQueue<vertexHeap>
+  {
+  public:
+    searchQueue(vertexHeap &kept, int n)
+        : q(kept)
+    {
+      if (q.capacity() != n)
+      {
+        q = vertexHeap(n);
+      }
+      else
+      {
+        q.clear(); // An earlier search may have stopped with vertices still queued.
+      }
+    }
+
+    vertexHeap &get() { return q; }
+
+  private:
+    vertexHeap &q;
+  };
 }
 
-// Executes Dijkstra's algorithm to calculate shortest paths from source.
+// Looks up the starting vertex by name and runs Dijkstra's algorithm from its number.
+template <typename PriorityQueue>
 void Graph::dijkstra(const string &startVertex)
 {
-  Vertex *source = static_cast<Vertex *>(vertices.getPointer(startVertex));
-  if (!source)
+  int source = names.find(startVertex);
+  if (source == -1)
   {
     cerr << "Error: Starting vertex '" << startVertex << "' not found in graph." << endl;
     return;
   }
+  dijkstra<PriorityQueue>(source);
+}
 
-  // Initializes all vertices to max distance and unprocessed state.
-  for (auto &v : vertexList)
+// Runs Dijkstra's algorithm with the given queue into the graph's own search state.
+template <typename PriorityQueue>
+void Graph::dijkstra(int source)
+{
+  if (search<PriorityQueue>(source, -1, last, false) != 0)
   {
-    v->distance = INT32_MAX; // Set max distance.
-    v->known = false;        // Mark as unprocessed.
-    v->previous = nullptr;   // No previous vertex yet.
+    cerr << "Error: Starting vertex number " << source << " is out of range." << endl;
   }
+}
 
-  source->distance = 0; // Sets source distance to zero.
+// Executes Dijkstra's algorithm to calculate shortest paths from source, until target is settled.
+// Only reads the graph, so threads with their own states may search at the same time.
+template <typename PriorityQueue>
+int Graph::search(int source, int target, searchState &state, bool backward) const
+{
+  if (source < 0 || source >= names.size() || target < -1 || target >= names.size())
+  {
+    return 1;
+  }
+
+  // Follows the edges, or the reversed edges for distances to source.
+  const int *starts = backward ? reverseStart : edgeStart;
+  const int *heads = backward ? reverseSource : edgeTarget;
+  const int *weights = backward ? reverseWeight : edgeWeight;
+
+  // Starts a new epoch, so every vertex reads as unreached without being touched.
+  state.begin(names.size());
+  const uint32_t reached = state.epoch, settled = state.epoch + 1;
+  searchState::entry *entries = state.entries.data();
+  entries[source] = {0, -1, reached}; // Sets source distance to zero.
 
   // Adds source vertex to the min-heap.
-  heap minHeap(vertexList.size());
-  int insertStatus = minHeap.insert(source->id, source->distance, source);
+  searchQueue<PriorityQueue> queue(state.heap, names.size());
+  PriorityQueue &minHeap = queue.get();
+  int insertStatus = pushVertex(minHeap, names, source, 0);
   if (insertStatus != 0) // Verifies successful insertion.
   {
     cerr << "Error: Failed to insert source vertex into heap." << endl;
-    return;
+    return 0;
   }
 
   // Loop through all vertices in heap to determine shortest paths.
-  while (minHeap.currentSize > 0)
+  while (!minHeap.empty())
   {
-    string vertexName;
-    int dist;
-    Vertex *u = nullptr;
+    int u, key;
 
-    // Extracts the vertex with minimum distance.
-    if (minHeap.deleteMin(&vertexName, &dist, reinterpret_cast<void **>(&u)) != 0)
+    // Extracts the vertex with minimum distance; its distance is already recorded.
+    if (popVertex(minHeap, u, key) != 0)
     {
       cerr << "Error: Failed to delete min from heap." << endl;
       break;
     }
 
-    if (!u) // Skips null vertices.
+    if (entries[u].stamp == settled) // Skips already processed vertices.
     {
-      cerr << "Error: Extracted null vertex from heap." << endl;
       continue;
     }
 
-    if (u->known) // Skips already processed vertices.
+    entries[u].stamp = settled; // Marks vertex as processed.
+    state.settled++;
+    if (u == target)
+    {
+      break; // The target's distance is final; the rest of the tree is not needed.
+    }
+
+    // Updates neighboring vertices if a shorter path is found.
+    int distanceU = entries[u].distance;
+    for (int e = starts[u]; e < starts[u + 1]; ++e)
+    {
+      int v = heads[e];
+      int newDist = distanceU + weights[e];
+      searchState::entry &ev = entries[v];
+
+      // Updates vertex with new shortest distance if applicable; a stale stamp means unreached.
+      if (ev.stamp < reached || (ev.stamp == reached && newDist < ev.distance))
+      {
+        ev = {newDist, u, reached};
+
+        // Inserts the vertex, or adjusts its position if it is already in the heap.
+        if (pushVertex(minHeap, names, v, newDist) != 0)
+        {
+          cerr << "Error: Failed to insert/update vertex " << names.name(v) << " in heap." << endl;
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+// Finds a shortest path with the queue that suits the weights seen in loadGraph.
+int Graph::shortestPath(int source, int target, pathState &state, vector<int> &path) const
+{
+  if (minWeight < 0)
+  {
+    // Meeting in the middle relies on non-negative weights, so search one way to the target.
+    path.clear();
+    if (target < 0 || search(source, target, state.forward) != 0)
+    {
+      return -1;
+    }
+    for (int v = state.forward.distance(target) == INT32_MAX ? -1 : target; v != -1; v = state.forward.previous(v))
+    {
+      path.push_back(v);
+    }
+    reverse(path.begin(), path.end());
+    return state.forward.distance(target);
+  }
+  else if (maxWeight <= maxDialWeight)
+  {
+    return shortestPath<bucketQueue>(source, target, state, path);
+  }
+  else
+  {
+    return shortestPath<radixHeap>(source, target, state, path);
+  }
+}
+
+// Bidirectional Dijkstra: side 0 searches forward from source, side 1 backward from target over the
+// reverse graph, each step settling a vertex on the side whose last settled distance is smaller. Every
+// edge scanned into a vertex the other side has reached gives a source-to-target path; the search stops
+// once the two sides' smallest queued distances add up to at least the best such path.
+template <typename PriorityQueue>
+int Graph::shortestPath(int source, int target, pathState &state, vector<int> &path) const
+{
+  path.clear();
+  if (source < 0 || source >= names.size() || target < 0 || target >= names.size())
+  {
+    return -1;
+  }
+
+  searchState *sides[2] = {&state.forward, &state.backward};
+  const int *starts[2] = {edgeStart, reverseStart};
+  const int *heads[2] = {edgeTarget, reverseSource};
+  const int *weights[2] = {edgeWeight, reverseWeight};
+  searchQueue<PriorityQueue> forwardHolder(state.forward.heap, names.size());
+  searchQueue<PriorityQueue> backwardHolder(state.backward.heap, names.size());
+  PriorityQueue &forwardQueue = forwardHolder.get(), &backwardQueue = backwardHolder.get();
+  PriorityQueue *queues[2] = {&forwardQueue, &backwardQueue};
+  int origins[2] = {source, target};
+  long long lastKey[2] = {0, 0}; // Distance last taken from each side; nothing smaller is queued there.
+
+  for (int side = 0; side < 2; ++side)
+  {
+    sides[side]->begin(names.size());
+    sides[side]->entries[origins[side]] = {0, -1, sides[side]->epoch};
+    if (pushVertex(*queues[side], names, origins[side], 0) != 0)
+    {
+      cerr << "Error: Failed to insert source vertex into heap." << endl;
+      return INT32_MAX;
+    }
+  }
+
+  // The best path found so far runs through vertex meet.
+  long long best = (source == target) ? 0 : INT32_MAX;
+  int meet = source;
+
+  while (!forwardQueue.empty() && !backwardQueue.empty())
+  {
+    int side = (lastKey[0] <= lastKey[1]) ? 0 : 1;
+    searchState &here = *sides[side];
+    const searchState &there = *sides[1 - side];
+
+    int u, key;
+    if (popVertex(*queues[side], u, key) != 0)
+    {
+      cerr << "Error: Failed to delete min from heap." << endl;
+      break;
+    }
+    lastKey[side] = key;
+
+    searchState::entry *entries = here.entries.data();
+    const uint32_t reached = here.epoch, settled = here.epoch + 1;
+    if (entries[u].stamp == settled) // Skips already processed vertices.
     {
       continue;
     }
+    if (key + lastKey[1 - side] >= best)
+    {
+      break; // No path through a vertex still queued on either side can be shorter.
+    }
+    entries[u].stamp = settled;
+    here.settled++;
 
-    u->known = true; // Marks vertex as processed.
+    int distanceU = entries[u].distance;
+    for (int e = starts[side][u]; e < starts[side][u + 1]; ++e)
+    {
+      int v = heads[side][e];
+      int newDist = distanceU + weights[side][e];
+      searchState::entry &ev = entries[v];
+      if (ev.stamp < reached || (ev.stamp == reached && newDist < ev.distance))
+      {
+        ev = {newDist, u, reached};
+        if (pushVertex(*queues[side], names, v, newDist) != 0)
+        {
+          cerr << "Error: Failed to insert/update vertex " << names.name(v) << " in heap." << endl;
+        }
+      }
 
-    // Updates neighboring vertices if a shorter path is found.
-    for (const auto &edge : u->adjList)
+      // A vertex both sides have reached joins the two halves of a path.
+      if (there.reached(v) && ev.distance + static_cast<long long>(there.entries[v].distance) < best)
+      {
+        best = ev.distance + static_cast<long long>(there.entries[v].distance);
+        meet = v;
+      }
+    }
+  }
+
+  if (best >= INT32_MAX)
+  {
+    return INT32_MAX;
+  }
+
+  // The forward half is read back to the source, the backward half onward to the target.
+  for (int v = meet; v != -1; v = state.forward.previous(v))
+  {
+    path.push_back(v);
+  }
+  reverse(path.begin(), path.end());
+  for (int v = state.backward.previous(meet); v != -1; v = state.backward.previous(v))
+  {
+    path.push_back(v);
+  }
+  return best;
+}
+
+template int Graph::shortestPath<vertexHeap>(int source, int target, pathState &state, vector<int> &path) const;
+template int Graph::shortestPath<radixHeap>(int source, int target, pathState &state, vector<int> &path) const;
+template int Graph::shortestPath<bucketQueue>(int source, int target, pathState &state, vector<int> &path) const;
+
+// Picks each landmark as far as possible from the others, recording distances to and from it.
+void Graph::buildLandmarks(int k, landmarkTable &table) const
+{
+  int n = names.size();
+  k = max(0, min(k, n));
+  table.vertices.clear();
+  table.distances.assign(2 * static_cast<size_t>(n) * k, INT32_MAX);
+  if (k == 0)
+  {
+    return;
+  }
+
+  // Round-trip distance from each vertex to its nearest landmark so far; unreachable counts as farthest.
+  const long long unreachable = 1LL << 40;
+  vector<long long> nearest(n, LLONG_MAX);
+  auto farthest = [&]()
+  {
+    int best = 0;
+    for (int v = 1; v < n; ++v)
+    {
+      if (nearest[v] > nearest[best])
+      {
+        best = v;
+      }
+    }
+    return best;
+  };
+
+  // The first landmark is the vertex farthest from vertex 0.
+  searchState forward, backward;
+  search(0, -1, forward);
+  for (int v = 0; v < n; ++v)
+  {
+    nearest[v] = (forward.distance(v) == INT32_MAX) ? -1 : forward.distance(v);
+  }
+  int next = farthest();
+  fill(nearest.begin(), nearest.end(), LLONG_MAX);
+
+  for (int i = 0; i < k; ++i)
+  {
+    table.vertices.push_back(next);
+    search(next, -1, forward);
+    search(next, -1, backward, true);
+    for (int v = 0; v < n; ++v)
+    {
+      int from = forward.distance(v), to = backward.distance(v);
+      table.distances[2 * (static_cast<size_t>(v) * k + i)] = from;
+      table.distances[2 * (static_cast<size_t>(v) * k + i) + 1] = to;
+      long long roundTrip = (from == INT32_MAX ? unreachable : from) + static_cast<long long>(to == INT32_MAX ? unreachable : to);
+      nearest[v] = min(nearest[v], roundTrip);
+    }
+    next = farthest();
+  }
+}
+
+namespace
+{
+  // Lower bounds on the distance to one target from the landmarks' distances.
+  class landmarkBound
+  {
+  public:
+    // Keeps the target's own distances to and from each landmark.
+    landmarkBound(const Graph::landmarkTable &table, int target)
+        : k(table.count()), all(table.distances.data()),
+          ofTarget(all + 2 * static_cast<size_t>(target) * k, all + 2 * (static_cast<size_t>(target) + 1) * k)
     {
-      Vertex *v = edge.destination;
-      int newDist = u->distance + edge.weight;
+    }
 
-      // Updates vertex with new shortest distance if applicable.
-      if (!v->known && newDist < v->distance)
+    // Returns a lower bound on the distance from v to the target, or -1 if v cannot reach it:
+    // v cannot reach a landmark that the target reaches.
+    int operator()(int v) const
+    {
+      const int *ofV = all + 2 * static_cast<size_t>(v) * k;
+      int bound = 0;
+      for (int i = 0; i < 2 * k; i += 2)
       {
-        v->distance = newDist;
-        v->previous = u;
+        if (ofTarget[i + 1] != INT32_MAX)
+        {
+          if (ofV[i + 1] == INT32_MAX)
+          {
+            return -1;
+          }
+          bound = max(bound, ofV[i + 1] - ofTarget[i + 1]); // d(v, L) - d(t, L).
+        }
+        if (ofTarget[i] != INT32_MAX && ofV[i] != INT32_MAX)
+        {
+          bound = max(bound, ofTarget[i] - ofV[i]); // d(L, t) - d(L, v).
+        }
+      }
+      return bound;
+    }
+
+  private:
+    int k;
+    const int *all;
+    vector<int> ofTarget;
+  };
+}
+
+// Finds a path with A* when the weights allow a monotone queue.
+int Graph::landmarkPath(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const
+{
+  if (minWeight < 0 || table.count() == 0)
+  {
+    // The bounds need non-negative weights; without them this is a search that stops at the target.
+    path.clear();
+    if (target < 0 || search(source, target, state) != 0)
+    {
+      return -1;
+    }
+    for (int v = state.distance(target) == INT32_MAX ? -1 : target; v != -1; v = state.previous(v))
+    {
+      path.push_back(v);
+    }
+    reverse(path.begin(), path.end());
+    return state.distance(target);
+  }
+  else if (maxWeight <= maxDialWeight)
+  {
+    return landmarkPath<bucketQueue>(source, target, table, state, path);
+  }
+  else
+  {
+    return landmarkPath<radixHeap>(source, target, table, state, path);
+  }
+}
+
+// A* search: vertices are queued by distance plus the lower bound on what is left. The bounds are
+// consistent (an edge never lowers the bound by more than its weight), so queue keys never decrease
+// and a settled vertex's distance is final, as in Dijkstra's algorithm.
+template <typename PriorityQueue>
+int Graph::landmarkPath(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const
+{
+  path.clear();
+  if (source < 0 || source >= names.size() || target < 0 || target >= names.size() ||
+      table.distances.size() != 2 * static_cast<size_t>(names.size()) * table.count())
+  {
+    return -1;
+  }
+
+  landmarkBound bound(table, target);
+  state.begin(names.size());
+  const uint32_t reached = state.epoch, settled = state.epoch + 1;
+  searchState::entry *entries = state.entries.data();
+
+  int sourceBound = bound(source);
+  if (sourceBound == -1)
+  {
+    return INT32_MAX; // The source cannot reach a landmark the target reaches.
+  }
+  entries[source] = {0, -1, reached};
+  searchQueue<PriorityQueue> queue(state.heap, names.size());
+  PriorityQueue &minHeap = queue.get();
+  if (pushVertex(minHeap, names, source, sourceBound) != 0)
+  {
+    cerr << "Error: Failed to insert source vertex into heap." << endl;
+    return INT32_MAX;
+  }
 
-        int heapStatus = minHeap.insert(v->id, v->distance, v);
-        if (heapStatus == 2) // Adjusts position if vertex is already in heap.
+  while (!minHeap.empty())
+  {
+    int u, key;
+    if (popVertex(minHeap, u, key) != 0)
+    {
+      cerr << "Error: Failed to delete min from heap." << endl;
+      break;
+    }
+    if (entries[u].stamp == settled) // Skips already processed vertices.
+    {
+      continue;
+    }
+    entries[u].stamp = settled;
+    state.settled++;
+    if (u == target)
+    {
+      break;
+    }
+
+    int distanceU = entries[u].distance;
+    for (int e = edgeStart[u]; e < edgeStart[u + 1]; ++e)
+    {
+      int v = edgeTarget[e];
+      int newDist = distanceU + edgeWeight[e];
+      searchState::entry &ev = entries[v];
+      if (ev.stamp < reached || (ev.stamp == reached && newDist < ev.distance))
+      {
+        int vBound = bound(v);
+        if (vBound == -1)
         {
-          minHeap.setKey(v->id, v->distance);
+          continue; // No path to the target leads through v.
         }
-        else if (heapStatus != 0) // Checks for insertion failure.
+        ev = {newDist, u, reached};
+        if (pushVertex(minHeap, names, v, newDist + vBound) != 0)
         {
-          cerr << "Error: Failed to insert/update vertex " << v->id << " in heap." << endl;
+          cerr << "Error: Failed to insert/update vertex " << names.name(v) << " in heap." << endl;
         }
       }
     }
   }
+
+  if (state.distance(target) == INT32_MAX)
+  {
+    return INT32_MAX;
+  }
+  for (int v = target; v != -1; v = state.previous(v))
+  {
+    path.push_back(v);
+  }
+  reverse(path.begin(), path.end());
+  return state.distance(target);
+}
+
+template int Graph::landmarkPath<vertexHeap>(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const;
+template int Graph::landmarkPath<radixHeap>(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const;
+template int Graph::landmarkPath<bucketQueue>(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const;
+
+// Adds up the lightest edge between each pair of consecutive vertices.
+long long Graph::pathLength(const vector<int> &path) const
+{
+  long long length = 0;
+  for (size_t i = 1; i < path.size(); ++i)
+  {
+    int u = path[i - 1], v = path[i];
+    long long lightest = -1;
+    for (int e = edgeStart[u]; e < edgeStart[u + 1]; ++e)
+    {
+      if (edgeTarget[e] == v && (lightest == -1 || edgeWeight[e] < lightest))
+      {
+        lightest = edgeWeight[e];
+      }
+    }
+    if (lightest == -1)
+    {
+      return -1;
+    }
+    length += lightest;
+  }
+  return length;
+}
+
+// Hands out sources one at a time to the threads, which keep their state between searches.
+int Graph::searchMany(const vector<int> &sources, int threads, const searchDone &done) const
+{
+  threads = max(1, min<int>(threads, sources.size()));
+  atomic<size_t> next(0);
+  atomic<int> skipped(0);
+  auto worker = [&]()
+  {
+    searchState state;
+    for (size_t i = next++; i < sources.size(); i = next++)
+    {
+      if (search(sources[i], -1, state) != 0)
+      {
+        skipped++;
+        continue;
+      }
+      done(i, state);
+    }
+  };
+
+  vector<thread> pool;
+  for (int t = 1; t < threads; ++t)
+  {
+    pool.emplace_back(worker);
+  }
+  worker(); // The calling thread works too.
+  for (auto &t : pool)
+  {
+    t.join();
+  }
+  return skipped;
+}
+
+// Moves to the next epoch, clearing the stamps only when the counter would wrap.
+void Graph::searchState::begin(int n)
+{
+  if (static_cast<int>(entries.size()) != n || epoch >= UINT32_MAX - 2)
+  {
+    entries.assign(n, {INT32_MAX, -1, 0});
+    epoch = 0;
+  }
+  epoch += 2;
+  settled = 0;
+}
+
+// The priority queues Dijkstra's algorithm can run with.
+template void Graph::dijkstra<heap>(const string &startVertex);
+template void Graph::dijkstra<pairingHeap>(const string &startVertex);
+template void Graph::dijkstra<vertexHeap>(const string &startVertex);
+template void Graph::dijkstra<radixHeap>(const string &startVertex);
+template void Graph::dijkstra<bucketQueue>(const string &startVertex);
+template void Graph::dijkstra<heap>(int source);
+template void Graph::dijkstra<pairingHeap>(int source);
+template void Graph::dijkstra<vertexHeap>(int source);
+template void Graph::dijkstra<radixHeap>(int source);
+template void Graph::dijkstra<bucketQueue>(int source);
+template int Graph::search<heap>(int source, int target, searchState &state, bool backward) const;
+template int Graph::search<pairingHeap>(int source, int target, searchState &state, bool backward) const;
+template int Graph::search<vertexHeap>(int source, int target, searchState &state, bool backward) const;
+template int Graph::search<radixHeap>(int source, int target, searchState &state, bool backward) const;
+template int Graph::search<bucketQueue>(int source, int target, searchState &state, bool backward) const;
+
+// Copies the distances computed by the last run.
+void Graph::distances(vector<int> &out) const
+{
+  out.resize(names.size());
+  for (int v = 0; v < names.size(); ++v)
+  {
+    out[v] = last.distance(v);
+  }
 }
 
 // Outputs shortest paths from source to each reachable vertex.
@@ -170,34 +1205,43 @@ void Graph::outputPaths(const string &outFileName) const
     cerr << "Error: Could not open output file " << outFileName << endl;
     return;
   }
+  writePaths(outFile, last);
+  outFile.close();
+}
+
+// Formats and writes each vertex's shortest path and distance.
+void Graph::writePaths(ostream &out, const searchState &state) const
+{
+  for (int v = 0; v < names.size(); ++v)
+  {
+    out.write(names.data(v), names.length(v)) << ": ";
+    writePath(out, v, state);
+    out << '\n';
+  }
+}
 
-  // Formats and writes each vertex's shortest path and distance.
-  for (const auto &v : vertexList)
+// Writes the distance and path to one vertex, or NO PATH.
+void Graph::writePath(ostream &out, int v, const searchState &state) const
+{
+  if (state.distance(v) == INT32_MAX)
   {
-    outFile << v->id << ": ";
-    if (v->distance == INT32_MAX)
-    {
-      outFile << "NO PATH" << endl;
-    }
-    else
-    {
-      outFile << v->distance << " [" << formatPath(v) << "]" << endl;
-    }
+    out << "NO PATH";
+  }
+  else
+  {
+    out << state.distance(v) << " [" << formatPath(v, state) << "]";
   }
-  outFile.close();
 }
 
 // Constructs path from source to specified vertex.
-string Graph::formatPath(const Vertex *v) const
+string Graph::formatPath(int v, const searchState &state) const
 {
-  stack<string> pathStack;
-  const Vertex *current = v;
+  stack<int> pathStack;
 
-  // Builds path in reverse using previous pointers.
-  while (current)
+  // Builds path in reverse using previous vertices.
+  for (int current = v; current != -1; current = state.previous(current))
   {
-    pathStack.push(current->id);
-    current = current->previous;
+    pathStack.push(current);
   }
 
   if (pathStack.empty())
@@ -206,11 +1250,12 @@ string Graph::formatPath(const Vertex *v) const
   }
 
   // Formats path by popping elements from stack.
-  string path = pathStack.top();
+  string path = names.name(pathStack.top());
   pathStack.pop();
   while (!pathStack.empty())
   {
-    path += ", " + pathStack.top();
+    path += ", ";
+    path.append(names.data(pathStack.top()), names.length(pathStack.top()));
     pathStack.pop();
   }
   return path;
@@ -2,70 +2,261 @@
 #define GRAPH_H
 
 #include <string>
-#include <list>
+#include <ostream>
 #include <climits>
+#include <cstdint>
+#include <vector>
+#include <functional>
 #include "heap.h"
+#include "pairingHeap.h"
+#include "vertexHeap.h"
+#include "radixHeap.h"
+#include "bucketQueue.h"
 #include "hash.h"
+#include "nameTable.h"
 
 using namespace std;
 
 class Graph
 {
 public:
-    // Initializes the graph by loading from the specified input file.
+    // Initializes the graph by loading from the specified input file, either a text edge list
+    // or a binary graph file written by save, which is mapped and used in place.
     Graph(const string &input_file);
 
-    // Cleans up dynamically allocated Vertex objects.
+    // Unmaps a binary graph file.
     ~Graph();
 
-    // Runs Dijkstra's algorithm from the specified starting vertex.
+    // The adjacency may point into a mapping owned by the graph, so graphs are not copied.
+    Graph(const Graph &) = delete;
+    Graph &operator=(const Graph &) = delete;
+
+    // Writes the graph to a binary graph file.
+    // Returns 0 on success, 1 if the file could not be written.
+    int save(const string &binaryFile) const;
+
+    // Working state of one search, indexed by vertex number. Each entry is stamped with the search
+    // that last wrote it, so starting a search just moves to a new epoch and entries left by earlier
+    // searches read as unreached: a search costs what it touches rather than the number of vertices.
+    // Every thread searching the graph at the same time needs its own.
+    class searchState
+    {
+    public:
+        // Returns the distance to v found by the last search, or INT32_MAX if it was not reached.
+        int distance(int v) const { return reached(v) ? entries[v].distance : INT32_MAX; }
+
+        // Returns the vertex before v on its shortest path, or -1.
+        int previous(int v) const { return reached(v) ? entries[v].previous : -1; }
+
+        // Returns the number of vertices the last search settled.
+        int settledCount() const { return settled; }
+
+    private:
+        friend class Graph;
+        friend class contractionHierarchy;
+
+        // Everything a relaxation reads about a vertex, side by side.
+        struct entry
+        {
+            int distance;   // Known shortest distance from source.
+            int previous;   // Previous vertex in the shortest path, or -1.
+            uint32_t stamp; // epoch once reached by the current search, epoch + 1 once settled.
+        };
+
+        vector<entry> entries; // Sized on the first search; empty before it.
+        uint32_t epoch = 0;    // Even; entries stamped below it belong to earlier searches.
+        int settled = 0;       // Vertices settled by the current search.
+        vertexHeap heap = vertexHeap(0); // Kept for searches with the vertex heap, which costs O(V) to build.
+
+        // Returns true if the current search has reached v.
+        bool reached(int v) const { return v >= 0 && v < static_cast<int>(entries.size()) && entries[v].stamp >= epoch; }
+
+        // Starts a new search over n vertices.
+        void begin(int n);
+    };
+
+    // Runs Dijkstra's algorithm from the specified starting vertex,
+    // with the priority queue that suits the graph's edge weights.
     void dijkstra(const string &startVertex);
 
+    // Runs Dijkstra's algorithm with the given priority queue
+    // (heap, pairingHeap, vertexHeap, radixHeap or bucketQueue).
+    template <typename PriorityQueue>
+    void dijkstra(const string &startVertex);
+
+    // The same, from a vertex number returned by findVertex.
+    template <typename PriorityQueue>
+    void dijkstra(int source);
+
+    // Runs Dijkstra's algorithm from source into state, stopping once target's distance is final
+    // (target -1 computes the whole tree), with the queue dijkstra would choose or the one given.
+    // With backward set it follows the edges in reverse, giving distances to source instead of from it.
+    // The graph is only read, so threads may search at once, each with its own state.
+    // Returns 0 on success, 1 if source or target is out of range.
+    int search(int source, int target, searchState &state, bool backward = false) const;
+    template <typename PriorityQueue>
+    int search(int source, int target, searchState &state, bool backward = false) const;
+
+    // Working state of a point-to-point search, one search state for each direction.
+    struct pathState
+    {
+        searchState forward;  // Distances from the source over the edges.
+        searchState backward; // Distances to the target over the reversed edges.
+
+        // Returns the number of vertices the last search settled on both sides.
+        int settledCount() const { return forward.settledCount() + backward.settledCount(); }
+    };
+
+    // Finds a shortest path from source to target with bidirectional Dijkstra: one search forward from
+    // source and one backward from target over the reverse graph, stopping once the frontiers have met
+    // and no shorter meeting is possible. The queue is chosen as in dijkstra or given; with negative
+    // weights the untemplated version searches from source only, as meeting in the middle needs them non-negative.
+    // path receives the vertex numbers from source to target, or is left empty if there is no path.
+    // Returns the distance, INT32_MAX if target cannot be reached, or -1 if source or target is out of range.
+    int shortestPath(int source, int target, pathState &state, vector<int> &path) const;
+    template <typename PriorityQueue>
+    int shortestPath(int source, int target, pathState &state, vector<int> &path) const;
+
+    // Distances between every vertex and a few landmark vertices, for goal-directed search (ALT).
+    // By the triangle inequality, d(v, t) >= d(v, L) - d(t, L) and d(v, t) >= d(L, t) - d(L, v) for any
+    // landmark L, which gives A* a lower bound on the distance left from any vertex to the target.
+    struct landmarkTable
+    {
+        vector<int> vertices;  // The landmarks.
+        vector<int> distances; // distances[2 * (v * count() + i)] is the distance from landmark i to v and the
+                               // next entry the distance from v to it, or INT32_MAX; a vertex's entries are together.
+
+        // Returns the number of landmarks.
+        int count() const { return vertices.size(); }
+
+        // Returns the bytes taken by the distances.
+        size_t memoryBytes() const { return distances.size() * sizeof(int); }
+    };
+
+    // Chooses k landmarks with the farthest heuristic: the first is the vertex farthest from vertex 0,
+    // and each next one the vertex farthest (going there and back) from the landmarks chosen so far.
+    // Each landmark costs one search forward and one backward over the whole graph.
+    void buildLandmarks(int k, landmarkTable &table) const;
+
+    // Finds a shortest path from source to target with A* search guided by the landmarks' lower bounds,
+    // which settles only vertices whose distance plus bound is below the target's distance.
+    // The queue is chosen as in dijkstra or given; with negative weights the untemplated version
+    // searches without the bounds. Returns the same as shortestPath.
+    int landmarkPath(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const;
+    template <typename PriorityQueue>
+    int landmarkPath(int source, int target, const landmarkTable &table, searchState &state, vector<int> &path) const;
+
+    // Returns the length of a path given as vertex numbers, taking the lightest edge between each pair,
+    // or -1 if some pair has no edge.
+    long long pathLength(const vector<int> &path) const;
+
+    // Called by searchMany with the position of a source in its list and that source's finished search.
+    typedef function<void(size_t, const searchState &)> searchDone;
+
+    // Computes the shortest-path tree of every source on a pool of threads sharing the graph, each
+    // thread reusing one search state. A tree is handed to done on the thread that computed it as
+    // soon as it is finished, in no particular order, and is overwritten by that thread's next
+    // search, so only one tree per thread is ever held. done may run on several threads at once.
+    // Sources out of range are skipped; returns their number.
+    int searchMany(const vector<int> &sources, int threads, const searchDone &done) const;
+
     // Outputs shortest paths from the starting vertex to each vertex in the graph to a file.
     void outputPaths(const string &outFileName) const;
 
+    // Writes every vertex's shortest path from a search, one line each as in outputPaths.
+    void writePaths(ostream &out, const searchState &state) const;
+
+    // Writes the distance and path to vertex v from a search, or NO PATH.
+    void writePath(ostream &out, int v, const searchState &state) const;
+
+    // Returns a vertex's ID.
+    string vertexName(int v) const { return names.name(v); }
+
     // Checks if a vertex with the given ID exists in the graph.
     bool isValidVertex(const string &vertexId) const;
 
-private:
-    struct Vertex; // Forward declaration for Vertex usage within Edge struct.
+    // Returns the number of the vertex with the given ID, or -1 if there is none.
+    // Vertices are numbered 0 to vertexCount() - 1; names are only needed for input and output.
+    int findVertex(const string &vertexId) const { return names.find(vertexId); }
 
-    // Represents a directed edge with a weight.
-    struct Edge
+    // Copies each vertex's distance from the last run, in insertion order.
+    void distances(vector<int> &out) const;
+
+    // Returns the number of vertices.
+    int vertexCount() const { return names.size(); }
+
+    // Returns the number of edges.
+    int edgeCount() const { return edges; }
+
+    // Returns the number of edges leaving v, pointing targets and weights at their destinations and weights.
+    int outEdges(int v, const int *&targets, const int *&weights) const
     {
-        int weight;          // Edge weight.
-        Vertex *destination; // Pointer to destination vertex.
+        targets = edgeTarget + edgeStart[v];
+        weights = edgeWeight + edgeStart[v];
+        return edgeStart[v + 1] - edgeStart[v];
+    }
 
-        Edge(Vertex *dest, int w) : destination(dest), weight(w) {} // Initializes edge.
-    };
+    // Returns the smallest and largest edge weights.
+    int smallestWeight() const { return minWeight; }
+    int largestWeight() const { return maxWeight; }
 
-    // Represents a node in the graph.
-    struct Vertex
+private:
+    // Represents a directed edge with a weight, as read from the file.
+    struct Edge
     {
-        string id;          // Vertex ID.
-        int distance;       // Known shortest distance from source.
-        bool known;         // Processed flag for Dijkstra's.
-        Vertex *previous;   // Previous vertex in the shortest path.
-        list<Edge> adjList; // Outgoing edges.
-
-        Vertex(const string &vertexId)
-            : id(vertexId), distance(INT32_MAX), known(false), previous(nullptr) {}
+        int source; // Index of the source vertex.
+        int target; // Index of the destination vertex.
+        int weight; // Edge weight.
     };
 
-    hashTable vertices;        // Hash table for vertex lookup by ID.
-    list<Vertex *> vertexList; // Maintains vertex insertion order.
+    nameTable names; // Vertex IDs, numbered 0, 1, ... in order of first appearance in the file.
+    int minWeight;   // Smallest edge weight seen while loading.
+    int maxWeight;   // Largest edge weight seen while loading.
+
+    // Adjacency in compressed sparse row form, built once loading is done: the edges
+    // leaving vertex v are edgeTarget[e] and edgeWeight[e] for e from edgeStart[v] to edgeStart[v + 1] - 1,
+    // in file order, so a relaxation loop reads two contiguous arrays instead of chasing list nodes.
+    // The arrays are the vectors below for a text file, or lie in the mapping of a binary file.
+    int edges;              // Number of edges.
+    const int *edgeStart;   // First edge of each vertex, plus one past the last edge.
+    const int *edgeTarget;  // Destination vertex of each edge.
+    const int *edgeWeight;  // Weight of each edge.
+    vector<int> startStore; // Storage of the arrays when they were built from a text file.
+    vector<int> targetStore;
+    vector<int> weightStore;
+
+    // The same for the reverse graph, built at load time for searching backward from a target:
+    // the edges entering v come from reverseSource[e] with weight reverseWeight[e], for e from
+    // reverseStart[v] to reverseStart[v + 1] - 1.
+    const int *reverseStart;
+    const int *reverseSource;
+    const int *reverseWeight;
+    vector<int> reverseStartStore;
+    vector<int> reverseSourceStore;
+    vector<int> reverseWeightStore;
+
+    void *mapped;           // Mapping of a binary graph file, or nullptr.
+    size_t mappedSize;      // Length of the mapping.
+
+    searchState last; // Results of the last run of dijkstra, for outputPaths and distances.
 
     // Loads graph structure from the specified file.
     void loadGraph(const string &fileName);
 
-    // Inserts a weighted edge between two vertices.
-    void insertEdge(const string &sourceId, const string &destId, int weight);
+    // Parses a text edge list on several threads.
+    void parseGraph(const char *text, size_t size);
+
+    // Uses a mapped binary graph file in place; returns false if it is not one.
+    bool attachGraph(const char *data, size_t size, const string &fileName);
+
+    // Builds the compressed sparse row arrays from the edges read.
+    void buildAdjacency(const vector<Edge> &edges);
 
-    // Retrieves or creates a vertex for the given name.
-    Vertex *getOrCreateVertex(const string &name);
+    // Builds the reverse graph's arrays from the forward ones.
+    void buildReverse();
 
     // Formats the path from source to a given vertex as a string.
-    string formatPath(const Vertex *v) const;
+    string formatPath(int v, const searchState &state) const;
 };
 
 #endif // GRAPH_H
@@ -7,6 +7,7 @@
 #include "heap.h"
 #include <climits>
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -22,13 +23,38 @@ heap::heap(int capacity)
     mapping = hashTable(capacity * 2); // Hash table size set to twice the heap capacity.
 }
 
+// Constructor places the items as given, then restores heap order bottom-up.
+heap::heap(const vector<heapItem> &items)
+{
+    capacity = items.size();
+    currentSize = 0;
+    data.resize(capacity + 1);
+    mapping = hashTable(capacity * 2);
+
+    for (const heapItem &item : items)
+    {
+        if (mapping.contains(item.id))
+            continue; // Repeated ID.
+
+        currentSize++;
+        data[currentSize].id = item.id;
+        data[currentSize].key = item.key;
+        data[currentSize].pData = item.pData;
+        mapping.insert(item.id, &data[currentSize]);
+    }
+
+    // Percolating down every parent from the last one up costs O(n) in total.
+    for (int pos = currentSize / 2; pos >= 1; pos--)
+        percolateDown(pos);
+}
+
 // Inserts a node with given ID and key; returns error code on failure.
 int heap::insert(const string &id, int key, void *pv)
 {
-    if (currentSize >= capacity)
-        return 1; // Heap is full.
     if (mapping.contains(id))
         return 2; // ID already exists.
+    if (currentSize >= capacity)
+        grow(); // Heap is full.
 
     currentSize++;
     data[currentSize].id = id;
@@ -110,6 +136,26 @@ int heap::remove(const string &id, int *pKey, void **ppData)
     return 0;            // Node successfully removed.
 }
 
+// Doubles the capacity; resizing may move the nodes, so their hash table pointers are refreshed.
+void heap::grow()
+{
+    node *oldData = data.data();
+    capacity = max(1, capacity * 2);
+    data.resize(capacity + 1);
+
+    if (data.data() != oldData)
+    {
+        for (int pos = 1; pos <= currentSize; pos++)
+            mapping.setPointer(data[pos].id, &data[pos]);
+    }
+}
+
+// Reports whether the heap has no nodes left.
+bool heap::empty() const
+{
+    return currentSize == 0;
+}
+
 // Moves the node at the specified position up the heap to restore order.
 void heap::percolateUp(int posCur)
 {
@@ -7,17 +7,29 @@
 
 using namespace std;
 
+// Represents one item for building a heap in a batch.
+struct heapItem
+{
+    string id;   // Unique identifier for the item.
+    int key;     // Key value used to order the item.
+    void *pData; // Pointer to associated data.
+};
+
 class heap
 {
 public:
-    // Constructor: Initializes the heap with the specified capacity.
+    // Constructor: Initializes the heap with the specified starting capacity; it doubles whenever it fills up.
     heap(int capacity);
 
+    // Constructor: Builds the heap from a batch of items in linear time (Floyd's heapify).
+    // Items whose ID repeats an earlier item's are left out.
+    heap(const vector<heapItem> &items);
+
     // Destructor: Cleans up any dynamically allocated resources.
     ~heap();
 
     // Inserts a node into the heap with the given ID and key.
-    // Returns 0 on success, 1 if heap is full, 2 if ID already exists, 3 if hash table insertion fails.
+    // Returns 0 on success, 2 if ID already exists, 3 if hash table insertion fails.
     int insert(const string &id, int key, void *pv = nullptr);
 
     // Updates the key of the node with the specified ID and reheapifies.
@@ -32,6 +44,9 @@ public:
     // Returns 0 on success, 1 if ID not found.
     int remove(const string &id, int *pKey = nullptr, void **ppData = nullptr);
 
+    // Returns true if the heap holds no nodes.
+    bool empty() const;
+
     // Stores the current number of elements in the heap.
     int currentSize;
 
@@ -45,10 +60,13 @@ private:
         void *pData; // Pointer to associated data.
     };
 
-    int capacity;      // Maximum number of nodes the heap can hold.
+    int capacity;      // Number of nodes the heap can hold before it grows.
     vector<node> data; // Array-based representation of the heap (1-based indexing).
     hashTable mapping; // Hash table for quick lookup of nodes by ID.
 
+    // Doubles the capacity and points the hash table at the nodes' new addresses.
+    void grow();
+
     // Moves the node at the specified position up the heap to restore order.
     void percolateUp(int posCur);
 
@@ -2,20 +2,157 @@
    Name: Talha Akhlaq
    Description: Loads a graph from an input file, prompts the user for a starting vertex,
    applies Dijkstra's algorithm to compute shortest paths, and outputs the results to a file.
+   With --server it instead keeps the graph loaded and answers queries from standard input or a Unix socket,
+   and with --batch it writes the shortest paths from many starting vertices, searching on several threads.
 */
 
 #include "graph.h"
+#include "server.h"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <chrono>
 #include <iomanip>
+#include <thread>
+#include <vector>
+#include <set>
+#include <atomic>
+#include <cstdlib>
+#include <cerrno>
+#include <sys/stat.h>
 
 using namespace std;
 using namespace std::chrono;
 
-int main()
+// Loads the graph once and answers queries until the input ends or the server is stopped.
+int serverMode(int argc, char *argv[])
 {
+  if (argc < 3)
+  {
+    cerr << "Usage: " << argv[0] << " --server <graph file> [socket | -] [workers]" << endl;
+    return 1;
+  }
+
+  string socketPath = (argc > 3) ? argv[3] : "-";
+  int workers = (argc > 4) ? atoi(argv[4]) : static_cast<int>(thread::hardware_concurrency());
+  Graph g(argv[2]);
+  cerr << "Loaded " << g.vertexCount() << " vertices and " << g.edgeCount() << " edges" << endl;
+
+  if (socketPath == "-")
+  {
+    return serveStream(g, cin, cout, workers);
+  }
+  return runServer(g, socketPath, workers);
+}
+
+// Loads the graph once and writes one output file per starting vertex listed in a file.
+int batchMode(int argc, char *argv[])
+{
+  if (argc < 5)
+  {
+    cerr << "Usage: " << argv[0] << " --batch <graph file> <sources file | -> <output directory> [threads]" << endl;
+    return 1;
+  }
+
+  int threads = (argc > 5) ? atoi(argv[5]) : static_cast<int>(thread::hardware_concurrency());
+  string outputDir = argv[4];
+  if (mkdir(outputDir.c_str(), 0755) != 0 && errno != EEXIST)
+  {
+    cerr << "Error: Could not create output directory " << outputDir << endl;
+    return 1;
+  }
+
+  auto startTime = steady_clock::now();
+  Graph g(argv[2]);
+  auto loadedTime = steady_clock::now();
+
+  // Reads the starting vertices, one ID per line.
+  ifstream sourceFile;
+  if (string(argv[3]) != "-")
+  {
+    sourceFile.open(argv[3]);
+    if (!sourceFile.is_open())
+    {
+      cerr << "Error: Could not open file " << argv[3] << endl;
+      return 1;
+    }
+  }
+  istream &sourceStream = sourceFile.is_open() ? sourceFile : cin;
+
+  vector<string> ids;
+  vector<int> sources;
+  set<string> listed;
+  int failures = 0;
+  string id;
+  while (sourceStream >> id)
+  {
+    // The ID names the output file, so it must not lead out of the output directory.
+    if (id.find('/') != string::npos)
+    {
+      cerr << "Error: Starting vertex '" << id << "' cannot name an output file." << endl;
+      failures++;
+      continue;
+    }
+    // A vertex listed twice would have two threads writing the same file; its paths are written once.
+    if (!listed.insert(id).second)
+    {
+      continue;
+    }
+    int v = g.findVertex(id);
+    if (v == -1)
+    {
+      cerr << "Error: Starting vertex '" << id << "' not found in graph." << endl;
+      failures++;
+      continue;
+    }
+    ids.push_back(id);
+    sources.push_back(v);
+  }
+
+  // Each tree goes to its own file as soon as it is done, so trees are never gathered in memory.
+  atomic<int> writeFailures(0);
+  g.searchMany(sources, threads, [&](size_t i, const Graph::searchState &state)
+               {
+                 string outFileName = outputDir + "/" + ids[i] + ".out";
+                 ofstream outFile(outFileName);
+                 if (!outFile.is_open())
+                 {
+                   writeFailures++;
+                   return;
+                 }
+                 g.writePaths(outFile, state);
+                 outFile.close();
+                 if (!outFile)
+                 {
+                   writeFailures++;
+                 } });
+  auto endTime = steady_clock::now();
+
+  double loadTime = duration<double>(loadedTime - startTime).count();
+  double searchTime = duration<double>(endTime - loadedTime).count();
+  cout << "Total time (in seconds) to load the graph: " << loadTime << endl;
+  cout << "Total time (in seconds) for " << sources.size() << " starting vertices: " << searchTime
+       << " (" << sources.size() / searchTime << " per second)" << endl;
+  failures += writeFailures;
+  if (failures > 0)
+  {
+    cerr << failures << " starting vertices could not be searched or written" << endl;
+    return 1;
+  }
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc > 1 && string(argv[1]) == "--server")
+  {
+    return serverMode(argc, argv);
+  }
+  if (argc > 1 && string(argv[1]) == "--batch")
+  {
+    return batchMode(argc, argv);
+  }
+
   string inputFile, outputFile, startVertex;
 
   // Prompt the user to enter the name of the graph file.
@@ -0,0 +1,110 @@
+/*
+   Name: Talha Akhlaq
+   Description: Writes a random directed graph in the input format of dijkstra.exe, for benchmarking
+   on graphs of millions of edges. Vertices are named v0, v1, ...; the first edges form a cycle
+   through every vertex, so all of them are reachable from any starting vertex.
+   With --grid it writes a road-like graph instead: a grid where each vertex has a two-way road to the
+   vertices beside it, with a random length that is the same both ways.
+   Usage: makeGraph.exe <vertices> <edges> <max weight> <output file> [seed]
+          makeGraph.exe --grid <rows> <columns> <max weight> <output file> [seed]
+*/
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <random>
+#include <cstdlib>
+
+using namespace std;
+
+// Writes a rows x columns grid of two-way roads, vertex v(r * columns + c) at row r, column c.
+int writeGrid(int argc, char *argv[])
+{
+  if (argc < 6)
+  {
+    cerr << "Usage: " << argv[0] << " --grid <rows> <columns> <max weight> <output file> [seed]" << endl;
+    return 1;
+  }
+
+  long long rows = atoll(argv[2]);
+  long long columns = atoll(argv[3]);
+  int maxWeight = atoi(argv[4]);
+  unsigned int seed = (argc > 6) ? atoi(argv[6]) : 365;
+  if (rows < 1 || columns < 1 || maxWeight < 1)
+  {
+    cerr << "Error: The grid must have at least one row and column, and a positive max weight." << endl;
+    return 1;
+  }
+
+  ofstream outFile(argv[5]);
+  if (!outFile.is_open())
+  {
+    cerr << "Error: Could not open output file " << argv[5] << endl;
+    return 1;
+  }
+
+  mt19937_64 rng(seed);
+  for (long long r = 0; r < rows; ++r)
+  {
+    for (long long c = 0; c < columns; ++c)
+    {
+      long long v = r * columns + c;
+      if (c + 1 < columns)
+      {
+        long long weight = 1 + rng() % maxWeight;
+        outFile << 'v' << v << " v" << v + 1 << ' ' << weight << '\n';
+        outFile << 'v' << v + 1 << " v" << v << ' ' << weight << '\n';
+      }
+      if (r + 1 < rows)
+      {
+        long long weight = 1 + rng() % maxWeight;
+        outFile << 'v' << v << " v" << v + columns << ' ' << weight << '\n';
+        outFile << 'v' << v + columns << " v" << v << ' ' << weight << '\n';
+      }
+    }
+  }
+  outFile.close();
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc > 1 && string(argv[1]) == "--grid")
+  {
+    return writeGrid(argc, argv);
+  }
+
+  if (argc < 5)
+  {
+    cerr << "Usage: " << argv[0] << " <vertices> <edges> <max weight> <output file> [seed]" << endl;
+    return 1;
+  }
+
+  long long vertices = atoll(argv[1]);
+  long long edges = atoll(argv[2]);
+  int maxWeight = atoi(argv[3]);
+  unsigned int seed = (argc > 5) ? atoi(argv[5]) : 365;
+  if (vertices < 1 || edges < vertices || maxWeight < 1)
+  {
+    cerr << "Error: There must be at least one vertex, as many edges as vertices, and a positive max weight." << endl;
+    return 1;
+  }
+
+  ofstream outFile(argv[4]);
+  if (!outFile.is_open())
+  {
+    cerr << "Error: Could not open output file " << argv[4] << endl;
+    return 1;
+  }
+
+  mt19937_64 rng(seed);
+  for (long long e = 0; e < edges; ++e)
+  {
+    // The cycle first, then edges between random vertices.
+    long long from = (e < vertices) ? e : rng() % vertices;
+    long long to = (e < vertices) ? (e + 1) % vertices : rng() % vertices;
+    outFile << 'v' << from << " v" << to << ' ' << 1 + rng() % maxWeight << '\n';
+  }
+  outFile.close();
+  return 0;
+}
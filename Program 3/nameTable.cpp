@@ -0,0 +1,189 @@
+/* Name: Talha Akhlaq
+   Description: Implements the vertex name table: names are stored back to back, and an open-addressing
+   table with linear probing, kept at most half full, maps each name's hash to its number. The arrays
+   can be written to a file and used in place from a mapping of it.
+*/
+
+#include "nameTable.h"
+#include <cstring>
+
+using namespace std;
+
+namespace
+{
+    // Sizes of the flat form, written before the arrays.
+    struct tableHeader
+    {
+        int64_t count;     // Number of names.
+        int64_t charCount; // Total length of the names.
+        int64_t slotCount; // Size of the lookup table.
+    };
+
+    // Bytes needed to round n up to a multiple of 8.
+    size_t padding(size_t n)
+    {
+        return (8 - n % 8) % 8;
+    }
+}
+
+// Constructor sizes the table to stay under half full for the expected number of names.
+nameTable::nameTable(int expected)
+    : starts(1, 0)
+{
+    size_t capacity = 16;
+    while (capacity < 2 * static_cast<size_t>(expected))
+        capacity *= 2;
+    slots.assign(capacity, slot{0, -1});
+    refresh();
+}
+
+// Adds a name unless it is already there.
+int nameTable::intern(const char *name, size_t length, uint64_t h)
+{
+    size_t pos = findSlot(name, length, h);
+    if (slots[pos].v != -1)
+        return slots[pos].v;
+
+    int v = count;
+    chars.insert(chars.end(), name, name + length);
+    starts.push_back(chars.size());
+    hashes.push_back(h);
+    slots[pos] = slot{static_cast<uint32_t>(h >> 32), v};
+
+    if (2 * hashes.size() > slots.size())
+        grow();
+    refresh();
+    return v;
+}
+
+// Looks a name up without adding it.
+int nameTable::find(const char *name, size_t length) const
+{
+    return pSlots[findSlot(name, length, hash(name, length))].v;
+}
+
+// FNV-1a over the bytes of the name.
+uint64_t nameTable::hash(const char *name, size_t length)
+{
+    uint64_t h = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; ++i)
+    {
+        h ^= static_cast<unsigned char>(name[i]);
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+// Writes the header, then the 8-byte arrays, then the characters.
+void nameTable::write(ostream &out) const
+{
+    tableHeader header = {count, static_cast<int64_t>(charCount), static_cast<int64_t>(slotCount)};
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(pStarts), (count + 1) * sizeof(int64_t));
+    out.write(reinterpret_cast<const char *>(pHashes), count * sizeof(uint64_t));
+    out.write(reinterpret_cast<const char *>(pSlots), slotCount * sizeof(slot));
+    out.write(pChars, charCount);
+
+    const char zeros[8] = {0};
+    out.write(zeros, padding(charCount));
+}
+
+// Points the views at arrays laid out as write leaves them, checking that they fit.
+const char *nameTable::attach(const char *p, const char *end)
+{
+    tableHeader header;
+    if (end - p < static_cast<ptrdiff_t>(sizeof(header)))
+        return nullptr;
+    memcpy(&header, p, sizeof(header));
+    p += sizeof(header);
+
+    if (header.count < 0 || header.count > INT32_MAX || header.charCount < 0 || header.slotCount < 16 ||
+        (header.slotCount & (header.slotCount - 1)) != 0 || header.slotCount < 2 * header.count)
+        return nullptr;
+
+    size_t bytes = (header.count + 1) * sizeof(int64_t) + header.count * sizeof(uint64_t) +
+                   header.slotCount * sizeof(slot) + header.charCount + padding(header.charCount);
+    if (static_cast<size_t>(end - p) < bytes)
+        return nullptr;
+
+    // Damaged offsets would send name lookups out of bounds, and a table with no empty slot
+    // would make findSlot probe forever, so check the arrays before using them.
+    const int64_t *fileStarts = reinterpret_cast<const int64_t *>(p);
+    const slot *fileSlots = reinterpret_cast<const slot *>(fileStarts + header.count + 1 + header.count);
+    if (fileStarts[0] != 0 || fileStarts[header.count] != header.charCount)
+        return nullptr;
+    for (int64_t v = 0; v < header.count; ++v)
+    {
+        if (fileStarts[v + 1] < fileStarts[v])
+            return nullptr;
+    }
+
+    vector<bool> seen(header.count, false);
+    int64_t used = 0;
+    for (int64_t i = 0; i < header.slotCount; ++i)
+    {
+        int v = fileSlots[i].v;
+        if (v == -1)
+            continue;
+        if (v < 0 || v >= header.count || seen[v])
+            return nullptr;
+        seen[v] = true;
+        used++;
+    }
+    if (used != header.count || used == header.slotCount)
+        return nullptr;
+
+    chars.clear();
+    starts.clear();
+    hashes.clear();
+    slots.clear();
+    count = header.count;
+    charCount = header.charCount;
+    slotCount = header.slotCount;
+    pStarts = reinterpret_cast<const int64_t *>(p);
+    pHashes = reinterpret_cast<const uint64_t *>(pStarts + count + 1);
+    pSlots = reinterpret_cast<const slot *>(pHashes + count);
+    pChars = reinterpret_cast<const char *>(pSlots + slotCount);
+    return p + bytes;
+}
+
+// The vectors may have moved, so take their addresses again.
+void nameTable::refresh()
+{
+    count = starts.size() - 1;
+    charCount = chars.size();
+    slotCount = slots.size();
+    pChars = chars.data();
+    pStarts = starts.data();
+    pHashes = hashes.data();
+    pSlots = slots.data();
+}
+
+// Probes from the name's home slot; comparing tags first skips most string compares.
+size_t nameTable::findSlot(const char *name, size_t length, uint64_t h) const
+{
+    size_t mask = slotCount - 1;
+    uint32_t tag = static_cast<uint32_t>(h >> 32);
+    for (size_t pos = h & mask;; pos = (pos + 1) & mask)
+    {
+        const slot &s = pSlots[pos];
+        if (s.v == -1)
+            return pos;
+        if (s.tag == tag && this->length(s.v) == length && memcmp(data(s.v), name, length) == 0)
+            return pos;
+    }
+}
+
+// Places every name in a table twice the size.
+void nameTable::grow()
+{
+    slots.assign(2 * slots.size(), slot{0, -1});
+    size_t mask = slots.size() - 1;
+    for (size_t v = 0; v < hashes.size(); ++v)
+    {
+        size_t pos = hashes[v] & mask;
+        while (slots[pos].v != -1)
+            pos = (pos + 1) & mask;
+        slots[pos] = slot{static_cast<uint32_t>(hashes[v] >> 32), static_cast<int>(v)};
+    }
+}
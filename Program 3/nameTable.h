@@ -0,0 +1,96 @@
+#ifndef _NAMETABLE_H
+#define _NAMETABLE_H
+
+#include <vector>
+#include <string>
+#include <ostream>
+#include <cstddef>
+#include <cstdint>
+
+using namespace std;
+
+// Numbers vertex names densely (0, 1, ...) in the order they are first added.
+// The names are kept back to back in one character array, and lookups go through an
+// open-addressing table of name numbers with a 64-bit FNV-1a hash, so adding or finding
+// a name needs no string allocation and no per-character modulo, and usually touches
+// only the slot and the name's characters.
+// A table can be written out as flat arrays and later attached to them where they lie
+// (e.g. in a memory-mapped file) without reading or rebuilding anything.
+class nameTable
+{
+public:
+    // Constructor: Makes room for about the expected number of names; the table grows as needed.
+    nameTable(int expected = 0);
+
+    // Tables point into their own arrays, so they can be moved but not copied.
+    nameTable(const nameTable &) = delete;
+    nameTable &operator=(const nameTable &) = delete;
+    nameTable(nameTable &&) = default;
+    nameTable &operator=(nameTable &&) = default;
+
+    // Returns the number of a name, adding it with the next number if it is new.
+    // Not for attached tables, which are read-only.
+    int intern(const char *name, size_t length) { return intern(name, length, hash(name, length)); }
+
+    // The same, for a name whose hash has already been computed.
+    int intern(const char *name, size_t length, uint64_t h);
+
+    // Computes the FNV-1a hash of a name.
+    static uint64_t hash(const char *name, size_t length);
+
+    // Starts loading the table slot of a hash into the cache, ahead of an intern or find.
+    void prefetch(uint64_t h) const { __builtin_prefetch(&pSlots[h & (slotCount - 1)]); }
+
+    // Returns the number of a name, or -1 if it has not been added.
+    int find(const char *name, size_t length) const;
+    int find(const string &name) const { return find(name.data(), name.size()); }
+
+    // Returns the number of names.
+    int size() const { return count; }
+
+    // Returns a name's characters and length, or the name as a string.
+    const char *data(int v) const { return pChars + pStarts[v]; }
+    size_t length(int v) const { return pStarts[v + 1] - pStarts[v]; }
+    string name(int v) const { return string(data(v), length(v)); }
+
+    // Writes the table as flat arrays, padded to a multiple of 8 bytes.
+    void write(ostream &out) const;
+
+    // Makes the table a read-only view of arrays written by write, starting at an 8-byte aligned p.
+    // Returns the end of the arrays, or nullptr if they do not fit before end or are inconsistent.
+    const char *attach(const char *p, const char *end);
+
+private:
+    // One entry of the open-addressing table; the tag lets most probes skip the name itself.
+    struct slot
+    {
+        uint32_t tag; // High half of the name's hash.
+        int v;        // Number of the name, or -1 if the slot is empty.
+    };
+
+    // Arrays of a table being built; empty for an attached table.
+    vector<char> chars;      // Every name, back to back.
+    vector<int64_t> starts;  // Name v is chars[starts[v]] to chars[starts[v + 1] - 1].
+    vector<uint64_t> hashes; // Hash of each name, kept for growing the table.
+    vector<slot> slots;      // Table of name numbers; its size is a power of 2.
+
+    // The arrays in use, either the vectors above or attached ones.
+    int count;
+    size_t charCount;
+    size_t slotCount;
+    const char *pChars;
+    const int64_t *pStarts;
+    const uint64_t *pHashes;
+    const slot *pSlots;
+
+    // Points the views at the vectors after they change.
+    void refresh();
+
+    // Returns the slot holding the name, or the empty slot where it belongs.
+    size_t findSlot(const char *name, size_t length, uint64_t h) const;
+
+    // Doubles the table and places every name again.
+    void grow();
+};
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef _PAIRINGHEAP_H
+#define _PAIRINGHEAP_H
+
+#include <vector>
+#include <string>
+#include "hash.h"
+
+using namespace std;
+
+// A pairing heap with the same interface as heap. Decreasing a key cuts the
+// node's subtree off and links it back at the root, which is O(1) amortized,
+// so it suits decrease-key heavy work such as Dijkstra's relaxations.
+// Nodes come from pools of storage; when they run out another pool as large
+// as the current capacity is added, so the capacity doubles.
+class pairingHeap
+{
+public:
+    // Constructor: sets initial capacity of heap.
+    pairingHeap(int capacity);
+
+    // Inserts a node with key, optional data pointer, and id.
+    // Returns 0 on success, 2 if id already exists, 3 if hash table insert fails.
+    int insert(const string &id, int key, void *pv = nullptr);
+
+    // Updates key of node by id.
+    // Returns 0 on success, 1 if id not found.
+    int setKey(const string &id, int key);
+
+    // Deletes the node with the smallest key.
+    // Optionally writes id, key, and data of the deleted node.
+    // Returns 0 on success, 1 if heap is empty.
+    int deleteMin(string *pId = nullptr, int *pKey = nullptr, void **ppData = nullptr);
+
+    // Removes node by id and optionally writes its key and data.
+    // Returns 0 on success, 1 if id not found.
+    int remove(const string &id, int *pKey = nullptr, void **ppData = nullptr);
+
+    // Moves every node of other into this heap, along with other's node pool,
+    // so the capacity becomes the sum of both; other is left empty with no capacity.
+    // Returns 0 on success, 1 if other is this heap, 2 if an id is in both heaps (nothing is moved),
+    // 3 if hash table insert fails (both heaps are left as they were).
+    int meld(pairingHeap &other);
+
+    // Returns the number of nodes in the heap.
+    int size() const { return currentSize; }
+
+    // Returns true if the heap holds no nodes.
+    bool empty() const { return currentSize == 0; }
+
+private:
+    // Defines the structure for each heap node.
+    class node
+    {
+    public:
+        string id;   // Node id.
+        int key;     // Node key.
+        void *pData; // Pointer to node's associated data.
+        node *child; // Leftmost child.
+        node *next;  // Next sibling.
+        node *prev;  // Previous sibling, or the parent for a leftmost child.
+    };
+
+    int capacity;               // Nodes in all pools; grows as pools are added.
+    int currentSize;            // Current number of elements.
+    node *root;                 // Node with the smallest key, or nullptr when empty.
+    vector<vector<node>> pools; // Node storage; melding adopts the other heap's pools.
+    vector<node *> freeNodes;   // Pool nodes not currently in the heap.
+    vector<node *> scratch;     // Reused by mergePairs and meld.
+    hashTable mapping;          // Maps ids to nodes.
+
+    // Adds a pool of the given number of nodes to the free list.
+    void addPool(int nodes);
+
+    // Makes the root with the larger key the leftmost child of the other; returns the new root.
+    node *link(node *a, node *b);
+
+    // Unlinks a non-root node (with its subtree) from its parent and siblings.
+    void cut(node *pn);
+
+    // Combines a list of siblings into one tree with the two-pass pairing rule.
+    node *mergePairs(node *first);
+
+    // Takes a node out of the heap; its children are merged back in.
+    void detach(node *pn);
+
+    // Looks up the node for an id; returns nullptr if the id is not in the heap.
+    node *find(const string &id);
+
+    // Returns a detached node to the pool, optionally writing its id, key and data.
+    void release(node *pn, string *pId, int *pKey, void **ppData);
+};
+
+#endif
@@ -0,0 +1,161 @@
+/*
+   Name: Talha Akhlaq
+   Description: Compares ways of answering point-to-point queries on random pairs of vertices: a full
+   Dijkstra run from the source, a run that stops once the target is settled, bidirectional Dijkstra,
+   A* with landmarks (ALT) and contraction hierarchies (CH), whose preprocessing time and memory are
+   reported too. Reports the average number of vertices each settles and its average time per query,
+   and checks that all give the same distances and that each returned path has the length reported.
+   The hierarchy is read from a file written by buildHierarchy.exe, and left out if none is given.
+   Usage: pathBench.exe <graph file> [queries] [seed] [landmarks] [hierarchy file]
+*/
+
+#include "graph.h"
+#include "contractionHierarchy.h"
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+
+using namespace std;
+using namespace std::chrono;
+
+// Totals of one method over all queries.
+struct methodTotals
+{
+  const char *name;
+  double seconds = 0;
+  long long settled = 0;
+};
+
+int main(int argc, char *argv[])
+{
+  if (argc < 2)
+  {
+    cerr << "Usage: " << argv[0] << " <graph file> [queries] [seed] [landmarks] [hierarchy file]" << endl;
+    return 1;
+  }
+
+  int queries = (argc > 2) ? atoi(argv[2]) : 100;
+  unsigned int seed = (argc > 3) ? atoi(argv[3]) : 365;
+  int landmarkCount = (argc > 4) ? atoi(argv[4]) : 8;
+  Graph g(argv[1]);
+  if (queries < 1 || g.vertexCount() == 0)
+  {
+    cerr << "Error: The number of queries and the graph must not be empty." << endl;
+    return 1;
+  }
+
+  auto preprocessStart = steady_clock::now();
+  Graph::landmarkTable landmarks;
+  g.buildLandmarks(landmarkCount, landmarks);
+  double preprocessTime = duration<double>(steady_clock::now() - preprocessStart).count();
+
+  int methods = (argc > 5) ? 5 : 4;
+  preprocessStart = steady_clock::now();
+  contractionHierarchy hierarchy;
+  if (argc > 5 && hierarchy.load(argv[5], g) != 0)
+  {
+    cerr << "Error: Could not load a hierarchy for this graph from " << argv[5] << endl;
+    return 1;
+  }
+  double hierarchyTime = duration<double>(steady_clock::now() - preprocessStart).count();
+
+  mt19937 rng(seed);
+  uniform_int_distribution<int> pick(0, g.vertexCount() - 1);
+  Graph::searchState state;
+  Graph::pathState pathState;
+  vector<int> paths[3];
+  methodTotals totals[5];
+  totals[0].name = "full Dijkstra";
+  totals[1].name = "stop at target";
+  totals[2].name = "bidirectional";
+  totals[3].name = "ALT";
+  totals[4].name = "CH";
+  int unreachable = 0;
+
+  for (int q = 0; q < queries; ++q)
+  {
+    int source = pick(rng), target = pick(rng);
+    int distances[5];
+
+    auto start = steady_clock::now();
+    g.search(source, -1, state);
+    totals[0].seconds += duration<double>(steady_clock::now() - start).count();
+    totals[0].settled += state.settledCount();
+    distances[0] = state.distance(target);
+
+    start = steady_clock::now();
+    g.search(source, target, state);
+    totals[1].seconds += duration<double>(steady_clock::now() - start).count();
+    totals[1].settled += state.settledCount();
+    distances[1] = state.distance(target);
+
+    start = steady_clock::now();
+    distances[2] = g.shortestPath(source, target, pathState, paths[0]);
+    totals[2].seconds += duration<double>(steady_clock::now() - start).count();
+    totals[2].settled += pathState.settledCount();
+
+    start = steady_clock::now();
+    distances[3] = g.landmarkPath(source, target, landmarks, state, paths[1]);
+    totals[3].seconds += duration<double>(steady_clock::now() - start).count();
+    totals[3].settled += state.settledCount();
+
+    if (methods > 4)
+    {
+      start = steady_clock::now();
+      distances[4] = hierarchy.query(source, target, pathState, &paths[2]);
+      totals[4].seconds += duration<double>(steady_clock::now() - start).count();
+      totals[4].settled += pathState.settledCount();
+    }
+
+    for (int m = 1; m < methods; ++m)
+    {
+      if (distances[m] != distances[0])
+      {
+        cerr << "Error: Query " << g.vertexName(source) << " -> " << g.vertexName(target) << " gave distance "
+             << distances[m] << " with " << totals[m].name << " instead of " << distances[0] << "." << endl;
+        return 1;
+      }
+    }
+    if (distances[0] == INT32_MAX)
+    {
+      unreachable++;
+      continue;
+    }
+    for (int p = 0; p < methods - 2; ++p)
+    {
+      const vector<int> &path = paths[p];
+      if (path.empty() || path.front() != source || path.back() != target || g.pathLength(path) != distances[0])
+      {
+        cerr << "Error: A path for " << g.vertexName(source) << " -> " << g.vertexName(target)
+             << " does not have the reported length." << endl;
+        return 1;
+      }
+    }
+  }
+
+  cout << g.vertexCount() << " vertices, " << g.edgeCount() << " edges, " << queries << " random queries ("
+       << unreachable << " without a path)" << endl;
+  cout << fixed << setprecision(2);
+  cout << landmarks.count() << " landmarks chosen in " << preprocessTime << " seconds, "
+       << landmarks.memoryBytes() / 1048576.0 << " MB in all, "
+       << (landmarks.count() > 0 ? landmarks.memoryBytes() / landmarks.count() / 1048576.0 : 0) << " MB per landmark" << endl;
+  if (methods > 4)
+  {
+    cout << "Hierarchy loaded in " << hierarchyTime << " seconds, "
+         << hierarchy.shortcutCount() << " shortcuts, " << hierarchy.coreSize() << " core vertices, "
+         << hierarchy.memoryBytes() / 1048576.0 << " MB" << endl;
+  }
+  cout << left << setw(18) << "Method" << right << setw(16) << "settled/query" << setw(14) << "ms/query" << setw(11) << "speedup" << endl;
+  for (int m = 0; m < methods; ++m)
+  {
+    const methodTotals &t = totals[m];
+    cout << left << setw(18) << t.name << right << setw(16) << setprecision(0) << static_cast<double>(t.settled) / queries
+         << setw(14) << setprecision(3) << t.seconds * 1000 / queries
+         << setw(10) << setprecision(1) << totals[0].seconds / t.seconds << "x" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,77 @@
+/* Name: Talha Akhlaq
+   Description: Implements a radix heap for monotone integer keys. deleteMin serves bucket 0 directly;
+   when it is empty, the lowest non-empty bucket is scanned for its minimum, which becomes the new last
+   key, and the bucket's entries are spread over the lower buckets relative to it.
+*/
+
+#include "radixHeap.h"
+
+using namespace std;
+
+// Constructor starts with empty buckets and a last key of zero.
+radixHeap::radixHeap(int)
+    : currentSize(0), last(0)
+{
+}
+
+// Inserts an entry unless its key would break the non-decreasing order of extraction.
+int radixHeap::insert(int key, int id)
+{
+    if (key < 0 || static_cast<unsigned int>(key) < last)
+        return 1; // Key is negative or below the last extracted key.
+
+    entry e = {static_cast<unsigned int>(key), id};
+    buckets[bucketOf(e.key)].push_back(e);
+    currentSize++;
+    return 0;
+}
+
+// Removes an entry with the smallest key and returns its details.
+int radixHeap::deleteMin(int *pKey, int *pId)
+{
+    if (currentSize == 0)
+        return 1; // Heap is empty.
+
+    if (buckets[0].empty())
+    {
+        // Find the lowest non-empty bucket and make its minimum the new last key.
+        int b = 1;
+        while (buckets[b].empty())
+            b++;
+
+        unsigned int newLast = buckets[b][0].key;
+        for (const entry &e : buckets[b])
+        {
+            if (e.key < newLast)
+                newLast = e.key;
+        }
+        last = newLast;
+
+        // Every entry of bucket b now differs from last in a lower bit, so it moves down.
+        for (const entry &e : buckets[b])
+            buckets[bucketOf(e.key)].push_back(e);
+        buckets[b].clear();
+    }
+
+    entry e = buckets[0].back();
+    buckets[0].pop_back();
+    currentSize--;
+
+    if (pKey)
+        *pKey = static_cast<int>(e.key);
+    if (pId)
+        *pId = e.id;
+    return 0;
+}
+
+// Reports whether the heap has no entries left.
+bool radixHeap::empty() const
+{
+    return currentSize == 0;
+}
+
+// Finds the bucket of a key: one past the highest bit in which it differs from last.
+int radixHeap::bucketOf(unsigned int key) const
+{
+    return key == last ? 0 : 32 - __builtin_clz(key ^ last);
+}
@@ -0,0 +1,47 @@
+#ifndef _RADIXHEAP_H
+#define _RADIXHEAP_H
+
+#include <vector>
+
+using namespace std;
+
+// A radix heap for non-negative integer keys that are extracted in non-decreasing order,
+// as in Dijkstra's algorithm with non-negative weights. An entry sits in the bucket numbered
+// by the highest bit in which its key differs from the last extracted key, so each entry
+// moves to a lower bucket at most 32 times in total.
+// Items are not tracked by id: lowering an item's key means inserting it again, and the
+// caller skips the stale entry when it comes out.
+class radixHeap
+{
+public:
+    // Constructor: Takes the expected number of items like the other queues; buckets grow as needed.
+    radixHeap(int capacity);
+
+    // Inserts an entry with the given key and item number.
+    // Returns 0 on success, 1 if the key is negative or below the last extracted key.
+    int insert(int key, int id);
+
+    // Deletes an entry with the smallest key and optionally returns its key and item number.
+    // Returns 0 on success, 1 if the heap is empty.
+    int deleteMin(int *pKey = nullptr, int *pId = nullptr);
+
+    // Returns true if the heap holds no entries.
+    bool empty() const;
+
+private:
+    // Represents one queued entry.
+    struct entry
+    {
+        unsigned int key; // Entry key.
+        int id;           // Item number, e.g. a vertex.
+    };
+
+    int currentSize;           // Number of entries in the heap.
+    unsigned int last;         // Last extracted key; no key below it may be inserted.
+    vector<entry> buckets[33]; // Bucket 0 holds keys equal to last, bucket b keys whose highest differing bit is b - 1.
+
+    // Returns the bucket for a key relative to last.
+    int bucketOf(unsigned int key) const;
+};
+
+#endif
@@ -0,0 +1,629 @@
+/*
+   Name: Talha Akhlaq
+   Description: Keeps a graph loaded and answers a stream of shortest-path queries, read from standard
+   input or from clients of a Unix domain socket, with a pool of worker threads that each own their
+   search state. Reports queries per second and latency percentiles when the queries end.
+*/
+
+#include "server.h"
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cerrno>
+#include <cstring>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/time.h>
+
+using namespace std;
+using namespace std::chrono;
+
+namespace
+{
+  // Set by the signal handler; polled by the accept loop.
+  volatile sig_atomic_t stopRequested = 0;
+
+  void onStopSignal(int)
+  {
+    stopRequested = 1;
+  }
+
+  // Time taken to answer each query, shared by the workers.
+  class latencyLog
+  {
+  public:
+    // Records the time one query took.
+    void add(double seconds)
+    {
+      lock_guard<mutex> lock(m);
+      times.push_back(seconds);
+    }
+
+    // Writes the query count, rate over the given wall time, and latency percentiles.
+    void report(ostream &out, double wallSeconds)
+    {
+      lock_guard<mutex> lock(m);
+      if (times.empty())
+      {
+        out << "No queries answered" << endl;
+        return;
+      }
+
+      sort(times.begin(), times.end());
+      auto percentile = [this](double p)
+      {
+        return times[min(times.size() - 1, static_cast<size_t>(p * times.size()))] * 1000;
+      };
+      out << fixed << setprecision(3);
+      out << "Answered " << times.size() << " queries in " << wallSeconds << " seconds ("
+          << times.size() / wallSeconds << " queries/sec)" << endl;
+      out << "Latency (ms): p50 " << percentile(0.50) << ", p90 " << percentile(0.90) << ", p99 "
+          << percentile(0.99) << ", max " << times.back() * 1000 << endl;
+    }
+
+  private:
+    mutex m;
+    vector<double> times;
+  };
+
+  // Answers one query line into reply; returns false for a blank line, which gets no answer.
+  bool answerQuery(const Graph &graph, const string &line, Graph::pathState &state, string &reply)
+  {
+    istringstream fields(line);
+    string sourceId, targetId;
+    if (!(fields >> sourceId))
+    {
+      return false;
+    }
+    fields >> targetId;
+
+    int source = graph.findVertex(sourceId);
+    int target = targetId.empty() ? -1 : graph.findVertex(targetId);
+    ostringstream out;
+    if (source == -1 || (!targetId.empty() && target == -1))
+    {
+      out << "Error: Unknown vertex '" << (source == -1 ? sourceId : targetId) << "'\n";
+    }
+    else
+    {
+      if (target == -1)
+      {
+        graph.search(source, -1, state.forward);
+        graph.writePaths(out, state.forward);
+      }
+      else
+      {
+        // One path only needs the bidirectional search.
+        vector<int> path;
+        int distance = graph.shortestPath(source, target, state, path);
+        out << sourceId << " -> " << targetId << ": ";
+        if (distance == INT32_MAX)
+        {
+          out << "NO PATH";
+        }
+        else
+        {
+          out << distance << " [";
+          for (size_t i = 0; i < path.size(); ++i)
+          {
+            out << (i > 0 ? ", " : "") << graph.vertexName(path[i]);
+          }
+          out << "]";
+        }
+        out << '\n';
+      }
+    }
+
+    // A whole tree is closed by an empty line so a client can tell where it ends.
+    if (targetId.empty() && source != -1)
+    {
+      out << '\n';
+    }
+    reply = out.str();
+    return true;
+  }
+
+  // Answers a query and records how long it took.
+  bool timedAnswer(const Graph &graph, const string &line, Graph::pathState &state, string &reply, latencyLog &log)
+  {
+    auto start = steady_clock::now();
+    bool answered = answerQuery(graph, line, state, reply);
+    if (answered)
+    {
+      log.add(duration<double>(steady_clock::now() - start).count());
+    }
+    return answered;
+  }
+
+  // Query lines numbered in input order, waiting for a worker.
+  class queryQueue
+  {
+  public:
+    // Adds a query and wakes one worker.
+    void push(long long index, string line)
+    {
+      {
+        lock_guard<mutex> lock(m);
+        queries.emplace_back(index, move(line));
+      }
+      ready.notify_one();
+    }
+
+    // Waits for a query; returns false once the queue is closed and drained.
+    bool pop(long long &index, string &line)
+    {
+      unique_lock<mutex> lock(m);
+      ready.wait(lock, [this]
+                 { return closed || !queries.empty(); });
+      if (queries.empty())
+      {
+        return false;
+      }
+      index = queries.front().first;
+      line = move(queries.front().second);
+      queries.pop_front();
+      return true;
+    }
+
+    // Stops taking queries and wakes all workers.
+    void close()
+    {
+      {
+        lock_guard<mutex> lock(m);
+        closed = true;
+      }
+      ready.notify_all();
+    }
+
+  private:
+    mutex m;
+    condition_variable ready;
+    deque<pair<long long, string>> queries;
+    bool closed = false;
+  };
+
+  // Answers finished in any order, handed to the writer in input order. The reader waits while
+  // too many answers are outstanding, so a slow output does not let memory grow without bound.
+  class replyQueue
+  {
+  public:
+    // Most queries read but not yet written.
+    static const long long window = 4096;
+
+    // Waits until query index may be read.
+    void waitForRoom(long long index)
+    {
+      unique_lock<mutex> lock(m);
+      changed.wait(lock, [this, index]
+                   { return index - written < window; });
+    }
+
+    // Stores the answer to query index; an unanswered (blank) query stores nothing but its turn.
+    void put(long long index, string reply)
+    {
+      {
+        lock_guard<mutex> lock(m);
+        done[index] = move(reply);
+      }
+      changed.notify_all();
+    }
+
+    // Records the number of queries read once the input ends.
+    void finish(long long count)
+    {
+      {
+        lock_guard<mutex> lock(m);
+        total = count;
+      }
+      changed.notify_all();
+    }
+
+    // Waits for the next answer in order; returns false after the last one.
+    bool take(string &reply)
+    {
+      unique_lock<mutex> lock(m);
+      changed.wait(lock, [this]
+                   { return done.count(written) != 0 || written == total; });
+      if (written == total)
+      {
+        return false;
+      }
+      reply = move(done[written]);
+      done.erase(written);
+      written++;
+      changed.notify_all();
+      return true;
+    }
+
+  private:
+    mutex m;
+    condition_variable changed;
+    map<long long, string> done;
+    long long written = 0; // Answers handed to the writer so far.
+    long long total = -1;  // Number of queries, once known.
+  };
+
+  // Fills in a Unix socket address; returns false if the path does not fit.
+  bool makeAddress(const string &socketPath, sockaddr_un &addr)
+  {
+    if (socketPath.size() >= sizeof(addr.sun_path))
+    {
+      return false;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    memcpy(addr.sun_path, socketPath.c_str(), socketPath.size() + 1);
+    return true;
+  }
+
+  // Sends the whole buffer, retrying short writes.
+  bool sendAll(int fd, const char *buf, size_t len)
+  {
+    while (len > 0)
+    {
+      ssize_t sent = send(fd, buf, len, MSG_NOSIGNAL);
+      if (sent < 0)
+      {
+        if (errno == EINTR)
+        {
+          continue;
+        }
+        return false;
+      }
+      buf += sent;
+      len -= sent;
+    }
+    return true;
+  }
+
+  // Most queries of one client read but not yet answered; the client is not read beyond it.
+  const long long clientWindow = 4096;
+
+  // Longest query line a client may send; a client sending more without a newline is dropped.
+  const size_t queryLineLimit = 65536;
+
+  // A client of the socket server. Its queries may be answered by different workers, and each
+  // answer is sent by the worker that completes the next one due, so they go out in query order.
+  class clientConnection
+  {
+  public:
+    const int fd;
+    string pending;         // A partial query line; used by the polling thread only.
+    long long received = 0; // Query lines read; used by the polling thread only.
+
+    explicit clientConnection(int socketFd)
+        : fd(socketFd)
+    {
+    }
+
+    // Closed once the client has hung up and its last answer has been sent.
+    ~clientConnection()
+    {
+      close(fd);
+    }
+
+    // Stores the answer to query index (empty for a blank line) and sends every answer now due.
+    void deliver(long long index, string reply)
+    {
+      lock_guard<mutex> lock(m);
+      done[index] = move(reply);
+      while (!done.empty() && done.begin()->first == sent)
+      {
+        const string &next = done.begin()->second;
+        if (!broken && !next.empty() && !sendAll(fd, next.data(), next.size()))
+        {
+          broken = true; // The client is gone; later answers are dropped.
+        }
+        done.erase(done.begin());
+        sent++;
+      }
+    }
+
+    // Returns the number of queries answered so far.
+    long long answered()
+    {
+      lock_guard<mutex> lock(m);
+      return sent;
+    }
+
+  private:
+    mutex m;
+    map<long long, string> done; // Answers waiting for an earlier one.
+    long long sent = 0;          // Answers delivered in order.
+    bool broken = false;         // Set once a send fails.
+  };
+
+  // A query line of a client, numbered in that client's order.
+  struct clientQuery
+  {
+    shared_ptr<clientConnection> client;
+    long long index;
+    string line;
+  };
+
+  // Query lines of all clients waiting for a worker, so no client holds a worker while it is idle.
+  class clientQueryQueue
+  {
+  public:
+    // Adds a query and wakes one worker.
+    void push(clientQuery query)
+    {
+      {
+        lock_guard<mutex> lock(m);
+        queries.push_back(move(query));
+      }
+      ready.notify_one();
+    }
+
+    // Waits for a query; returns false once the queue is closed and drained.
+    bool pop(clientQuery &query)
+    {
+      unique_lock<mutex> lock(m);
+      ready.wait(lock, [this]
+                 { return closed || !queries.empty(); });
+      if (queries.empty())
+      {
+        return false;
+      }
+      query = move(queries.front());
+      queries.pop_front();
+      return true;
+    }
+
+    // Stops taking queries and wakes all workers.
+    void close()
+    {
+      {
+        lock_guard<mutex> lock(m);
+        closed = true;
+      }
+      ready.notify_all();
+    }
+
+  private:
+    mutex m;
+    condition_variable ready;
+    deque<clientQuery> queries;
+    bool closed = false;
+  };
+
+  // Queues every complete line in a client's input.
+  void queueLines(const shared_ptr<clientConnection> &client, clientQueryQueue &queries)
+  {
+    string &pending = client->pending;
+    size_t start = 0, newline;
+    while ((newline = pending.find('\n', start)) != string::npos)
+    {
+      queries.push({client, client->received++, pending.substr(start, newline - start)});
+      start = newline + 1;
+    }
+    pending.erase(0, start);
+  }
+}
+
+// Reads queries on one thread, answers them on the workers and writes the answers in order.
+int serveStream(const Graph &graph, istream &in, ostream &out, int workers)
+{
+  if (workers < 1)
+  {
+    workers = 1;
+  }
+
+  queryQueue queries;
+  replyQueue replies;
+  latencyLog log;
+  auto start = steady_clock::now();
+
+  vector<thread> pool;
+  for (int i = 0; i < workers; ++i)
+  {
+    pool.emplace_back([&]()
+                      {
+                        Graph::pathState state; // Reused by every query this worker answers.
+                        long long index;
+                        string line, reply;
+                        while (queries.pop(index, line))
+                        {
+                          if (!timedAnswer(graph, line, state, reply, log))
+                          {
+                            reply.clear();
+                          }
+                          replies.put(index, move(reply));
+                        } });
+  }
+
+  thread reader([&]()
+                {
+                  long long count = 0;
+                  string line;
+                  while (getline(in, line))
+                  {
+                    replies.waitForRoom(count);
+                    queries.push(count++, move(line));
+                  }
+                  queries.close();
+                  replies.finish(count); });
+
+  string reply;
+  while (replies.take(reply))
+  {
+    out << reply;
+    out.flush(); // Answer each query as soon as it is ready, for an interactive client.
+  }
+
+  reader.join();
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+  log.report(cerr, duration<double>(steady_clock::now() - start).count());
+  return 0;
+}
+
+// Listens on the socket and hands the clients' query lines to the worker pool until stopped.
+int runServer(const Graph &graph, const string &socketPath, int workers)
+{
+  sockaddr_un addr;
+  if (!makeAddress(socketPath, addr))
+  {
+    cerr << "Error: Socket path is too long: " << socketPath << endl;
+    return 1;
+  }
+
+  int listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (listenFd < 0)
+  {
+    cerr << "Error: Could not create socket: " << strerror(errno) << endl;
+    return 1;
+  }
+
+  unlink(socketPath.c_str()); // Removes a stale socket left by an earlier run.
+  if (bind(listenFd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 || listen(listenFd, 128) != 0)
+  {
+    cerr << "Error: Could not listen on " << socketPath << ": " << strerror(errno) << endl;
+    close(listenFd);
+    return 1;
+  }
+
+  // Stops cleanly on SIGINT/SIGTERM; a client hanging up must not kill the server.
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = onStopSignal;
+  sigaction(SIGINT, &action, nullptr);
+  sigaction(SIGTERM, &action, nullptr);
+  signal(SIGPIPE, SIG_IGN);
+
+  if (workers < 1)
+  {
+    workers = 1;
+  }
+
+  clientQueryQueue queries;
+  latencyLog log;
+  auto start = steady_clock::now();
+  vector<thread> pool;
+  for (int i = 0; i < workers; ++i)
+  {
+    pool.emplace_back([&]()
+                      {
+                        Graph::pathState state; // Reused by every query this worker answers.
+                        clientQuery query;
+                        string reply;
+                        while (queries.pop(query))
+                        {
+                          if (!timedAnswer(graph, query.line, state, reply, log))
+                          {
+                            reply.clear();
+                          }
+                          query.client->deliver(query.index, move(reply));
+                          query.client.reset(); // Lets a finished client close now.
+                        } });
+  }
+
+  cout << "Listening on " << socketPath << " with " << workers << " workers" << endl;
+
+  // This thread polls the listening socket and every client, and hands complete query lines to the
+  // workers, so idle clients cost no worker and a stop signal is noticed within the poll timeout.
+  map<int, shared_ptr<clientConnection>> clients;
+  vector<pollfd> fds;
+  char buf[65536];
+  while (!stopRequested)
+  {
+    fds.assign(1, {listenFd, POLLIN, 0});
+    for (const auto &c : clients)
+    {
+      // A client with too many unanswered queries is left out until the workers catch up; polled
+      // without POLLIN, one that hung up would still wake poll at once and keep this thread spinning.
+      if (c.second->received - c.second->answered() < clientWindow)
+      {
+        fds.push_back({c.first, POLLIN, 0});
+      }
+    }
+    if (poll(fds.data(), fds.size(), 200) <= 0)
+    {
+      continue;
+    }
+
+    for (size_t i = 1; i < fds.size(); ++i)
+    {
+      if (fds[i].revents == 0)
+      {
+        continue;
+      }
+      auto it = clients.find(fds[i].fd);
+      ssize_t got = recv(fds[i].fd, buf, sizeof(buf), 0);
+      if (got < 0 && (errno == EINTR || errno == EAGAIN))
+      {
+        continue;
+      }
+      if (got > 0)
+      {
+        it->second->pending.append(buf, got);
+      }
+      else if (!it->second->pending.empty())
+      {
+        it->second->pending += '\n'; // A last query without a newline is still answered.
+      }
+      queueLines(it->second, queries);
+      if (it->second->pending.size() > queryLineLimit)
+      {
+        // Answered after the client's earlier queries; nothing more is read from it.
+        it->second->pending.clear();
+        it->second->deliver(it->second->received++,
+                            "Error: Query line longer than " + to_string(queryLineLimit) + " bytes\n");
+        shutdown(fds[i].fd, SHUT_RD);
+        got = 0;
+      }
+      if (got <= 0)
+      {
+        clients.erase(it); // Its queued queries keep it open until they are answered.
+      }
+    }
+
+    if (fds[0].revents & POLLIN)
+    {
+      int client = accept(listenFd, nullptr, nullptr);
+      if (client < 0)
+      {
+        if (errno == EINTR || errno == ECONNABORTED)
+        {
+          continue;
+        }
+        cerr << "Error: accept failed: " << strerror(errno) << endl;
+        break;
+      }
+
+      // A client that stops reading its answers only holds a worker for a while.
+      timeval sendTimeout = {5, 0};
+      setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &sendTimeout, sizeof(sendTimeout));
+      clients[client] = make_shared<clientConnection>(client);
+    }
+  }
+
+  // Answers the queries already read, then closes every connection.
+  queries.close();
+  for (auto &worker : pool)
+  {
+    worker.join();
+  }
+  clients.clear();
+
+  close(listenFd);
+  unlink(socketPath.c_str());
+  log.report(cerr, duration<double>(steady_clock::now() - start).count());
+  return 0;
+}
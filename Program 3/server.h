@@ -0,0 +1,31 @@
+#ifndef _SERVER_H
+#define _SERVER_H
+
+#include <string>
+#include <istream>
+#include <ostream>
+#include "graph.h"
+
+using namespace std;
+
+// Answers shortest-path queries on a loaded graph, one per line:
+//   source          writes every vertex's distance and path from source, as in the output file,
+//                   followed by an empty line;
+//   source target   writes "source -> target: " and the distance and path, or NO PATH.
+// Unknown vertices get a line starting with "Error:". Queries are answered by a pool of workers,
+// each with its own search state, sharing the graph. When the input ends, the number of queries,
+// queries per second and the 50th, 90th, 99th percentile and largest time to answer a query
+// are written to cerr.
+
+// Reads queries from in and writes the answers to out, in the order the queries came.
+// Returns 0.
+int serveStream(const Graph &graph, istream &in, ostream &out, int workers);
+
+// Serves queries on a Unix domain socket until SIGINT or SIGTERM. A client sends query lines
+// and reads back the answers in the same order; the lines of all clients share the workers,
+// so any number of clients can be connected, idle or not. A line longer than 64 KB is answered
+// with an error and ends the connection.
+// Returns 0 on a clean shutdown, 1 if the socket could not be set up.
+int runServer(const Graph &graph, const string &socketPath, int workers);
+
+#endif
@@ -0,0 +1,132 @@
+/* Name: Talha Akhlaq
+   Description: Implements a 4-ary heap of numbered items with an array from item numbers to heap
+   positions, supporting insertions, key updates and deletions of the minimum without any hashing.
+*/
+
+#include "vertexHeap.h"
+
+using namespace std;
+
+// Constructor makes every item absent and reserves room for all of them.
+vertexHeap::vertexHeap(int capacity)
+    : position(capacity > 0 ? capacity : 0, -1)
+{
+    data.reserve(position.size());
+}
+
+// Inserts an item with the given key; returns an error code on failure.
+int vertexHeap::insert(int id, int key)
+{
+    if (id < 0 || id >= static_cast<int>(position.size()))
+        return 1; // Number out of range.
+    if (position[id] != -1)
+        return 2; // Item already in the heap.
+
+    node n = {key, id};
+    data.push_back(n);
+    percolateUp(data.size() - 1);
+    return 0;
+}
+
+// Updates the key of an item and moves it up or down as needed.
+int vertexHeap::setKey(int id, int key)
+{
+    if (!contains(id))
+        return 1; // Item not in the heap.
+
+    int pos = position[id];
+    int oldKey = data[pos].key;
+    data[pos].key = key;
+    (key > oldKey) ? percolateDown(pos) : percolateUp(pos);
+    return 0;
+}
+
+// Removes the root (smallest key) and returns its details.
+int vertexHeap::deleteMin(int *pId, int *pKey)
+{
+    if (data.empty())
+        return 1; // Heap is empty.
+
+    if (pId)
+        *pId = data[0].id;
+    if (pKey)
+        *pKey = data[0].key;
+
+    position[data[0].id] = -1;
+    node last = data.back();
+    data.pop_back();
+    if (!data.empty())
+    {
+        data[0] = last; // Replace root with last node.
+        percolateDown(0);
+    }
+    return 0;
+}
+
+// Reports the root (smallest key) without changing the heap.
+int vertexHeap::peekMin(int *pId, int *pKey) const
+{
+    if (data.empty())
+        return 1; // Heap is empty.
+
+    if (pId)
+        *pId = data[0].id;
+    if (pKey)
+        *pKey = data[0].key;
+    return 0;
+}
+
+// Marks the queued items absent; the rest of the position array is already -1.
+void vertexHeap::clear()
+{
+    for (const node &n : data)
+        position[n.id] = -1;
+    data.clear();
+}
+
+// Moves the node at the specified position up the heap to restore order.
+void vertexHeap::percolateUp(int posCur)
+{
+    node tmp = data[posCur];
+
+    while (posCur > 0 && tmp.key < data[(posCur - 1) / 4].key)
+    {
+        int parent = (posCur - 1) / 4;
+        data[posCur] = data[parent]; // Move parent down to the current position.
+        position[data[posCur].id] = posCur;
+        posCur = parent;
+    }
+
+    data[posCur] = tmp;
+    position[tmp.id] = posCur;
+}
+
+// Moves the node at the specified position down the heap to restore order.
+void vertexHeap::percolateDown(int posCur)
+{
+    node tmp = data[posCur];
+    int size = data.size();
+
+    while (posCur * 4 + 1 < size) // Continue while there are children.
+    {
+        // Find the smallest of up to four children.
+        int first = posCur * 4 + 1;
+        int last = (first + 4 < size) ? first + 4 : size;
+        int child = first;
+        for (int c = first + 1; c < last; c++)
+        {
+            if (data[c].key < data[child].key)
+                child = c;
+        }
+
+        if (tmp.key <= data[child].key)
+            break; // Stop if the node is no larger than its children.
+
+        data[posCur] = data[child]; // Move child up to the current position.
+        position[data[posCur].id] = posCur;
+        posCur = child;
+    }
+
+    data[posCur] = tmp;
+    position[tmp.id] = posCur;
+}
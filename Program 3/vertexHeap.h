@@ -0,0 +1,68 @@
+#ifndef _VERTEXHEAP_H
+#define _VERTEXHEAP_H
+
+#include <vector>
+
+using namespace std;
+
+// A 4-ary min-heap of items numbered 0 to capacity - 1, such as the dense vertex numbers of a graph.
+// Each item's position in the heap is kept in an array indexed by its number, so finding an item
+// for setKey is one array read instead of hashing a string ID, and the heap nodes are just a key and
+// a number. With four children per node the heap is half as deep as a binary heap, which suits
+// Dijkstra's algorithm, where decrease-keys (moving up) far outnumber deleteMins (moving down).
+class vertexHeap
+{
+public:
+    // Constructor: Makes room for items numbered 0 to capacity - 1.
+    vertexHeap(int capacity);
+
+    // Inserts an item with the given number and key.
+    // Returns 0 on success, 1 if the number is out of range, 2 if the item is already in the heap.
+    int insert(int id, int key);
+
+    // Updates the key of an item and moves it to its new place.
+    // Returns 0 on success, 1 if the item is not in the heap.
+    int setKey(int id, int key);
+
+    // Deletes the item with the smallest key and optionally returns its number and key.
+    // Returns 0 on success, 1 if the heap is empty.
+    int deleteMin(int *pId = nullptr, int *pKey = nullptr);
+
+    // Optionally returns the number and key of the item with the smallest key without removing it.
+    // Returns 0 on success, 1 if the heap is empty.
+    int peekMin(int *pId = nullptr, int *pKey = nullptr) const;
+
+    // Removes every item, in time proportional to the number of items rather than the capacity.
+    void clear();
+
+    // Returns true if the item is in the heap.
+    bool contains(int id) const { return id >= 0 && id < static_cast<int>(position.size()) && position[id] != -1; }
+
+    // Returns the number of items in the heap.
+    int size() const { return data.size(); }
+
+    // Returns the number of items the heap has room for.
+    int capacity() const { return position.size(); }
+
+    // Returns true if the heap holds no items.
+    bool empty() const { return data.empty(); }
+
+private:
+    // Represents each node in the heap.
+    struct node
+    {
+        int key; // Key value used to maintain heap order.
+        int id;  // Number of the item.
+    };
+
+    vector<node> data;    // The heap, 0-based: the children of i are 4i + 1 to 4i + 4.
+    vector<int> position; // position[id] is the item's index in data, or -1 if it is not in the heap.
+
+    // Moves the node at the specified position up the heap to restore order.
+    void percolateUp(int posCur);
+
+    // Moves the node at the specified position down the heap to restore order.
+    void percolateDown(int posCur);
+};
+
+#endif